@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bench
+{
+	/*
+	* @brief The allocations made by the benchmarked code, counted by replacing the global allocation functions.
+	* The replacements live in their own translation unit : they are never inlined into the code they count,
+	* so that every allocation & its release are paired the same way.
+	*
+	* @return the number of allocations since the start of the program.
+	*/
+	size_t allocations();
+
+	/*
+	* @return the bytes allocated since the start of the program.
+	*/
+	size_t allocated();
+}
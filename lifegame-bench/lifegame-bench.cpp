@@ -0,0 +1,391 @@
+#include <bench/Allocations.hpp>
+#include <Dish.hpp>
+#include <Protocol.hpp>
+#include <Rule.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/*
+	* @brief The patterns filling the dishes.
+	*/
+	enum class Pattern
+	{
+		Soup, // randomly drawn cells.
+		Still, // blocks & beehives : nothing changes.
+		Guns, // Gosper glider guns : gliders are emitted until they crash into the border.
+	};
+
+	const char* name(Pattern pattern)
+	{
+		switch (pattern)
+		{
+		case Pattern::Soup: return "soup";
+		case Pattern::Still: return "still";
+		case Pattern::Guns: return "guns";
+		}
+		return "?";
+	}
+
+	/*
+	* @brief The Gosper glider gun, as 'row, column' pairs in a 9 x 36 box.
+	*/
+	const uint8_t GUN[][2] = {
+		{ 0, 24 },
+		{ 1, 22 }, { 1, 24 },
+		{ 2, 12 }, { 2, 13 }, { 2, 20 }, { 2, 21 }, { 2, 34 }, { 2, 35 },
+		{ 3, 11 }, { 3, 15 }, { 3, 20 }, { 3, 21 }, { 3, 34 }, { 3, 35 },
+		{ 4, 0 }, { 4, 1 }, { 4, 10 }, { 4, 16 }, { 4, 20 }, { 4, 21 },
+		{ 5, 0 }, { 5, 1 }, { 5, 10 }, { 5, 14 }, { 5, 16 }, { 5, 17 }, { 5, 22 }, { 5, 24 },
+		{ 6, 10 }, { 6, 16 }, { 6, 24 },
+		{ 7, 11 }, { 7, 15 },
+		{ 8, 12 }, { 8, 13 },
+	};
+
+	/*
+	* @brief Create a dish filled with a pattern.
+	*
+	* @return the dish, 'nullptr' if the pattern does not fit into the dish.
+	*/
+	std::unique_ptr<lifegame::Dish> create(Pattern pattern, uint8_t size, uint8_t density)
+	{
+		if (pattern == Pattern::Soup)
+		{
+			return std::make_unique<lifegame::Dish>(size, size, density, 42);
+		}
+
+		// Living cells are in [1, size], inside the immutable border.
+		std::vector<uint8_t> cells;
+		auto set = [&cells, size](int row, int column) {
+			if (row >= 0 && row < size && column >= 0 && column < size)
+			{
+				cells.push_back(static_cast<uint8_t>(row + 1));
+				cells.push_back(static_cast<uint8_t>(column + 1));
+				cells.push_back(1);
+			}
+		};
+		if (pattern == Pattern::Still)
+		{
+			// Alternating blocks & beehives, on a 6 x 6 grid.
+			for (int r = 0; r + 5 <= size; r += 6)
+			{
+				for (int c = 0; c + 5 <= size; c += 6)
+				{
+					if (((r + c) / 6) % 2 == 0)
+					{
+						set(r + 1, c + 1), set(r + 1, c + 2), set(r + 2, c + 1), set(r + 2, c + 2);
+					}
+					else
+					{
+						set(r + 1, c + 2), set(r + 1, c + 3), set(r + 2, c + 1), set(r + 2, c + 4), set(r + 3, c + 2), set(r + 3, c + 3);
+					}
+				}
+			}
+		}
+		else
+		{
+			// Guns spaced by room for their gliders.
+			if (size < 40)
+			{
+				return nullptr;
+			}
+			for (int r = 0; r + 9 <= size; r += 24)
+			{
+				for (int c = 0; c + 36 <= size; c += 48)
+				{
+					for (auto const& cell : GUN)
+					{
+						set(r + cell[0], c + cell[1]);
+					}
+				}
+			}
+		}
+		auto dish = std::make_unique<lifegame::Dish>(size, size, 0, 0);
+		dish->modify(cells);
+		return dish;
+	}
+
+	/*
+	* @brief The measures of a benchmark.
+	*/
+	struct Measure
+	{
+		uint64_t operations = 0;
+		uint64_t cells = 0; // the cells processed by all operations.
+		double seconds = 0;
+		size_t allocations = 0;
+		size_t allocated = 0;
+	};
+
+	/*
+	* @brief Run an operation until the minimum time is spent, timing the operation only.
+	*
+	* @param prepare the untimed preparation of a batch of operations.
+	* @param operate the timed operation, returning the number of processed cells.
+	*/
+	template <typename Prepare, typename Operate>
+	Measure measure(double minimum, unsigned int batch, Prepare prepare, Operate operate)
+	{
+		Measure measure;
+		while (measure.seconds < minimum)
+		{
+			prepare();
+			auto allocations = bench::allocations();
+			auto allocated = bench::allocated();
+			auto start = Clock::now();
+			for (unsigned int i = 0; i < batch; ++i)
+			{
+				measure.cells += operate();
+			}
+			measure.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+			measure.allocations += bench::allocations() - allocations;
+			measure.allocated += bench::allocated() - allocated;
+			measure.operations += batch;
+		}
+		return measure;
+	}
+
+	void report(const std::string& benchmark, const Measure& measure)
+	{
+		std::cout << std::left << std::setw(32) << benchmark << std::right << std::fixed
+			<< std::setw(14) << std::setprecision(1) << measure.seconds * 1e9 / measure.operations
+			<< std::setw(16) << std::setprecision(0) << measure.cells / measure.seconds
+			<< std::setw(14) << std::setprecision(1) << static_cast<double>(measure.allocated) / measure.operations
+			<< std::setw(12) << std::setprecision(2) << static_cast<double>(measure.allocations) / measure.operations << std::endl;
+	}
+
+	/*
+	* @brief Check that every engine lives the same generations : the same cells changed, in the same order, & the same dish.
+	* Every rule on both topologies, over dishes of several sizes (odd, even, thinner than a block or a band, the largest), several generations at once.
+	*
+	* @return the number of mismatches.
+	*/
+	unsigned int check()
+	{
+		const uint8_t sizes[] = { 1, 2, 3, 5, 16, 17, 64, 127, 253 };
+		const unsigned int steps[] = { 1, 2, 3, 7, 16, 64 };
+		const lifegame::Engine engines[] = { lifegame::Engine::Cells, lifegame::Engine::Blocks, lifegame::Engine::Tiles };
+		unsigned int cases = 0;
+		unsigned int mismatches = 0;
+		for (uint8_t r = 0; r < lifegame::RULES; ++r)
+		{
+			auto rule = static_cast<lifegame::Rule>(r);
+			for (uint8_t t = 0; t < lifegame::TOPOLOGIES; ++t)
+			{
+				auto topology = static_cast<lifegame::Topology>(t);
+				for (auto rows : sizes)
+				{
+					for (auto columns : { rows, static_cast<uint8_t>(rows == 253 ? 16 : rows + 1) })
+					{
+						// Each engine lives from the same dish, step after step : every step starts from the dish the previous ones gave.
+						lifegame::Dish initial(rows, columns, 35, rows * 256 + columns);
+						initial.topology(topology);
+						std::vector<lifegame::Dish> dishes(std::size(engines), initial);
+						for (auto generations : steps)
+						{
+							++cases;
+							std::vector<uint8_t> expected;
+							std::vector<uint8_t> expectedStates;
+							for (size_t e = 0; e < std::size(engines); ++e)
+							{
+								std::vector<uint8_t> cells;
+								std::vector<uint8_t> states;
+								dishes[e].live(cells, rule, engines[e], generations);
+								dishes[e].pack(states);
+								if (e == 0)
+								{
+									expected = std::move(cells);
+									expectedStates = std::move(states);
+								}
+								else if (cells != expected || states != expectedStates)
+								{
+									++mismatches;
+									std::cout << "Mismatch of the " << lifegame::name(engines[e]) << " engine: " << lifegame::name(rule) << "/" << lifegame::name(topology)
+										<< "/" << static_cast<int>(rows) << "x" << static_cast<int>(columns) << "/" << generations << " generations" << std::endl;
+									dishes[e] = dishes[0];
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+		std::cout << "Checked " << cases << " cases, mismatches: " << mismatches << std::endl;
+		return mismatches;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::cout << "Benchmark.\n";
+
+	// Only the benchmarks whose name holds the filter run, each one during at least the minimum time (in seconds).
+	// The 'check' filter compares the engines rather than benchmarking them.
+	std::string filter = argc > 1 ? argv[1] : "";
+	double minimum = argc > 2 ? std::stod(argv[2]) : 0.2;
+	if (filter == "check")
+	{
+		return check() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	std::cout << std::left << std::setw(32) << "benchmark" << std::right << std::setw(14) << "ns/op" << std::setw(16) << "cells/s"
+		<< std::setw(14) << "bytes/op" << std::setw(12) << "allocs/op" << std::endl;
+
+	const uint8_t sizes[] = { 16, 32, 64, 128, 253 };
+	const uint8_t densities[] = { 10, 35, 60 };
+	const unsigned int generations = 32; // lived from the same initial dish, so that soups do not turn into ashes.
+
+	struct Case
+	{
+		Pattern pattern;
+		uint8_t density;
+	};
+	std::vector<Case> cases;
+	for (auto density : densities)
+	{
+		cases.push_back({ Pattern::Soup, density });
+	}
+	cases.push_back({ Pattern::Still, 0 });
+	cases.push_back({ Pattern::Guns, 0 });
+
+	for (auto size : sizes)
+	{
+		uint64_t area = static_cast<uint64_t>(size) * size;
+		for (auto const& test : cases)
+		{
+			auto initial = create(test.pattern, size, test.density);
+			if (initial == nullptr)
+			{
+				continue;
+			}
+			std::string suffix = "/" + std::to_string(size) + "/" + name(test.pattern) + (test.pattern == Pattern::Soup ? std::to_string(test.density) : "");
+			auto selected = [&filter](const std::string& benchmark) {
+				return benchmark.find(filter) != std::string::npos;
+			};
+
+			if (test.pattern == Pattern::Soup && selected("construct" + suffix))
+			{
+				uint64_t seed = 0;
+				report("construct" + suffix, measure(minimum, 16, [] {}, [&] {
+					lifegame::Dish dish(size, size, test.density, ++seed);
+					return area;
+				}));
+			}
+
+			// Every rule on soups, Life only on still lifes & guns (Life patterns), by every engine. Life on a torus too.
+			for (uint8_t r = 0; r < (test.pattern == Pattern::Soup ? lifegame::RULES : 1); ++r)
+			{
+				auto rule = static_cast<lifegame::Rule>(r);
+				for (uint8_t t = 0; t < (rule == lifegame::Rule::Life ? lifegame::TOPOLOGIES : 1); ++t)
+				{
+					auto topology = static_cast<lifegame::Topology>(t);
+					for (auto engine : { lifegame::Engine::Cells, lifegame::Engine::Blocks })
+					{
+						auto benchmark = "live" + suffix + (rule == lifegame::Rule::Life ? "" : std::string("/") + lifegame::name(rule))
+							+ (topology == lifegame::Topology::Bounded ? "" : std::string("/") + lifegame::name(topology))
+							+ (engine == lifegame::Engine::Cells ? "" : std::string("/") + lifegame::name(engine));
+						if (selected(benchmark))
+						{
+							std::unique_ptr<lifegame::Dish> dish;
+							std::vector<uint8_t> cells;
+							report(benchmark, measure(minimum, generations, [&] {
+								dish = std::make_unique<lifegame::Dish>(*initial);
+								dish->topology(topology);
+							}, [&] {
+								cells.clear();
+								dish->live(cells, rule, engine);
+								return area;
+							}));
+						}
+					}
+				}
+			}
+
+			// Several generations at once, by every engine : Life only.
+			for (auto engine : { lifegame::Engine::Cells, lifegame::Engine::Blocks, lifegame::Engine::Tiles })
+			{
+				const unsigned int steps = 16;
+				auto benchmark = "live" + std::to_string(steps) + suffix + "/" + lifegame::name(engine);
+				if (selected(benchmark))
+				{
+					std::unique_ptr<lifegame::Dish> dish;
+					std::vector<uint8_t> cells;
+					report(benchmark, measure(minimum, generations / steps, [&] {
+						dish = std::make_unique<lifegame::Dish>(*initial);
+					}, [&] {
+						cells.clear();
+						dish->live(cells, lifegame::Rule::Life, engine, steps);
+						return area * steps;
+					}));
+				}
+			}
+
+			if (selected("cells" + suffix))
+			{
+				std::vector<uint8_t> cells;
+				report("cells" + suffix, measure(minimum, 16, [] {}, [&] {
+					cells.clear();
+					initial->cells(cells);
+					return area;
+				}));
+			}
+
+			if (selected("modify" + suffix))
+			{
+				// Applying a generation delta, then its reverse, leaves the dish unchanged.
+				lifegame::Dish dish(*initial);
+				std::vector<uint8_t> forward;
+				lifegame::Dish(*initial).live(forward);
+				std::vector<uint8_t> backward(forward);
+				for (size_t i = 2; i < backward.size(); i += 3)
+				{
+					backward[i] = !backward[i];
+				}
+				report("modify" + suffix, measure(minimum, 16, [] {}, [&] {
+					dish.modify(forward);
+					dish.modify(backward);
+					return forward.size() / 3 * 2;
+				}));
+			}
+
+			// Applying a generation delta in its smallest encoding, then its reverse : the flipped cells flip back.
+			{
+				std::vector<uint8_t> forward;
+				lifegame::protocol::header(lifegame::protocol::Reply::Delta, 1, forward);
+				lifegame::Dish(*initial).live(forward);
+				std::vector<uint8_t> backward(forward);
+				for (size_t i = lifegame::protocol::REPLY_HEADER_SIZE + 2; i < backward.size(); i += 3)
+				{
+					backward[i] = !backward[i];
+				}
+				std::vector<uint8_t> encodedForward;
+				std::vector<uint8_t> encodedBackward;
+				lifegame::protocol::delta(*initial, forward, encodedForward);
+				lifegame::protocol::delta(*initial, backward, encodedBackward);
+				auto encoding = static_cast<lifegame::protocol::Reply>(encodedForward.front());
+				auto benchmark = "apply" + suffix + "/" + (encoding == lifegame::protocol::Reply::Bitmap ? "bitmap" : encoding == lifegame::protocol::Reply::Runs ? "runs" : "cells");
+				if (selected(benchmark))
+				{
+					lifegame::Dish dish(*initial);
+					report(benchmark, measure(minimum, 16, [] {}, [&] {
+						lifegame::protocol::delta(encodedForward, dish);
+						lifegame::protocol::delta(encodedBackward, dish);
+						return (forward.size() - lifegame::protocol::REPLY_HEADER_SIZE) / 3 * 2;
+					}));
+				}
+			}
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
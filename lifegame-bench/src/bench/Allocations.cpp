@@ -0,0 +1,55 @@
+#include <bench/Allocations.hpp>
+#include <cstdlib>
+#include <new>
+
+static size_t allocations = 0;
+static size_t allocated = 0;
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	allocated += size;
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	::operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	::operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	::operator delete(memory);
+}
+
+namespace bench
+{
+	size_t allocations()
+	{
+		return ::allocations;
+	}
+
+	size_t allocated()
+	{
+		return ::allocated;
+	}
+}
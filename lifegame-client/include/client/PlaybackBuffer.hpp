@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace client
+{
+	/*
+	* @brief A jitter buffer, smoothing the playback of generations received at an irregular pace.
+	*
+	* Generations are played at a fixed rate, once enough of them have been buffered.
+	* When the buffer runs dry, the playback pauses until it is filled again.
+	*/
+	class PlaybackBuffer
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/*
+		* @brief Create a new buffer.
+		*
+		* @param rate the number of generations played per second, '0' to play them as soon as buffered.
+		* @param depth the number of generations to buffer before playing.
+		*/
+		PlaybackBuffer(unsigned int rate, size_t depth);
+
+		/*
+		* @brief Buffer a received generation.
+		*
+		* @param generation the generation number.
+		* @param delta the delta reply reaching the generation, in any of its encodings.
+		*/
+		void push(uint32_t generation, std::vector<uint8_t>&& delta);
+
+		/*
+		* @brief Retrieve the next generation to play, if it is time to.
+		*
+		* @param now the current time.
+		* @param generation the played generation number.
+		* @param delta the delta reply reaching the played generation, in any of its encodings.
+		*
+		* @return whether (or not) a generation is to be played.
+		*/
+		bool pop(Clock::time_point now, uint32_t& generation, std::vector<uint8_t>& delta);
+
+		/*
+		* @return the number of buffered generations.
+		*/
+		size_t size() const;
+
+		/*
+		* @return the number of times the playback has paused because the buffer ran dry.
+		*/
+		unsigned int underruns() const;
+
+	private:
+		struct Frame
+		{
+			uint32_t generation;
+			std::vector<uint8_t> delta;
+		};
+
+		std::deque<Frame> frames_;
+		Clock::duration period_;
+		Clock::time_point due_;
+		size_t depth_;
+		bool playing_ = false;
+		unsigned int underruns_ = 0;
+
+	};
+}
@@ -4,12 +4,36 @@
 #include <network/event/Disconnection.hpp>
 #include <network/event/Event.hpp>
 #include <network/event/Exchange.hpp>
+#include <client/PlaybackBuffer.hpp>
 #include <Cell.hpp>
 #include <Dish.hpp>
+#include <Grid.hpp>
+#include <Protocol.hpp>
+#include <Random.hpp>
+#include <Rule.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
 
 int main(int argc, char* argv[])
 {
+	// The standard output is kept for the display or the recording of the dish, the logs then go to the error output.
+	const char* display = std::getenv("LIFEGAME_DISPLAY"); // the most frames drawn per second into the terminal, none by default.
+	const char* record = std::getenv("LIFEGAME_RECORD"); // the directory of the images, or '-' for a stream of images to the standard output (a pipe to a video encoder), none by default.
+	bool piped = record != nullptr && std::string(record) == "-";
+	std::ostream output(std::cout.rdbuf());
+	if (display != nullptr || piped)
+	{
+		std::cout.rdbuf(std::cerr.rdbuf());
+	}
+
 	std::cout << "Client.\n";
 
 	if (argc <= 3)
@@ -18,15 +42,21 @@ int main(int argc, char* argv[])
 		return EXIT_FAILURE;
 	}
 
-	for (int i = 1; i < argc; i++)
+	// Numeric arguments, then the name of the shared dish to join.
+	for (int i = 1; i < argc && i <= 6; i++)
 	{
 		int value = std::stoi(argv[i], nullptr);
 		std::cout << "Argument " << i << ": " << value << std::endl;
-		if (value <= (std::numeric_limits<network::PacketUnit>::min)() || value > (std::numeric_limits<network::PacketUnit>::max)())
+		if (i <= 3 && (value <= (std::numeric_limits<network::PacketUnit>::min)() || value > (std::numeric_limits<network::PacketUnit>::max)()))
 		{
 			std::cerr << "Argument not in ]0, 255] range: " << value << std::endl;
 			return EXIT_FAILURE;
 		}
+		else if (value < (std::numeric_limits<network::PacketUnit>::min)() || value > (std::numeric_limits<network::PacketUnit>::max)())
+		{
+			std::cerr << "Argument not in [0, 255] range: " << value << std::endl;
+			return EXIT_FAILURE;
+		}
 	}
 
 	if (!network::startup())
@@ -47,7 +77,80 @@ int main(int argc, char* argv[])
 		int rows = std::stoi(argv[1], nullptr);
 		int columns = std::stoi(argv[2], nullptr);
 		int ratio = std::stoi(argv[3], nullptr);
-		lifegame::Dish dish(rows, columns, ratio);
+		int rate = argc > 4 ? std::stoi(argv[4], nullptr) : 0; // steps per second pushed by the server, '0' for client-driven steps.
+		uint32_t window = argc > 5 ? std::stoi(argv[5], nullptr) : 4; // steps requested ahead of their reception.
+		int fps = argc > 6 ? std::stoi(argv[6], nullptr) : 25; // generations played per second.
+		std::string name = argc > 7 ? argv[7] : ""; // the shared dish to join, empty for a private dish.
+		if (!name.empty() && rate == 0)
+		{
+			rate = 10; // A shared dish always lives at its own rate.
+		}
+		std::unique_ptr<lifegame::Dish> dish; // built from the seed sent by the server.
+		const char* token = std::getenv("LIFEGAME_TOKEN"); // the session token of a private dish to resume after a server restart.
+		const char* seek = std::getenv("LIFEGAME_SEEK"); // 'played,seeked' : once the played generation is reached, rewind the private dish to the seeked one.
+		const char* ruleName = std::getenv("LIFEGAME_RULE"); // the rule of a new dish, 'life' by default.
+		lifegame::Rule rule = lifegame::Rule::Life;
+		if (ruleName != nullptr && !lifegame::rule(ruleName, rule))
+		{
+			std::cerr << "Unknown rule: " << ruleName << std::endl;
+			return EXIT_FAILURE;
+		}
+		const char* topologyName = std::getenv("LIFEGAME_TOPOLOGY"); // the topology of a new dish, 'bounded' by default.
+		lifegame::Topology topology = lifegame::Topology::Bounded;
+		if (topologyName != nullptr && !lifegame::topology(topologyName, topology))
+		{
+			std::cerr << "Unknown topology: " << topologyName << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		const char* strideValue = std::getenv("LIFEGAME_STRIDE"); // the generations of a client-driven step, '1' by default : only the last one is received.
+		uint32_t stride = strideValue != nullptr ? std::stoi(strideValue) : 1;
+		if (stride == 0 || stride > (std::numeric_limits<network::PacketUnit>::max)())
+		{
+			std::cerr << "Stride not in ]0, 255] range: " << stride << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// The played generations are drawn into the terminal.
+		std::unique_ptr<lifegame::Grid> grid;
+		if (display != nullptr)
+		{
+			grid = std::make_unique<lifegame::Grid>(output, std::stoi(display));
+		}
+		uint32_t played = 0;
+
+		// Every played generation is recorded as a PPM image : the generations are then played as soon as received, rather than at the playback rate.
+		const char* scale = std::getenv("LIFEGAME_SCALE"); // the side of the square of each cell in the images, in pixels, '1' by default.
+		std::unique_ptr<lifegame::Grid> recorder;
+		if (record != nullptr)
+		{
+			if (piped && grid != nullptr)
+			{
+				std::cerr << "Display & recording both to the standard output." << std::endl;
+				return EXIT_FAILURE;
+			}
+			int dimension = scale != nullptr ? std::stoi(scale) : 1;
+			if (dimension <= 0 || dimension > (std::numeric_limits<uint8_t>::max)())
+			{
+				std::cerr << "Scale not in ]0, 255] range: " << dimension << std::endl;
+				return EXIT_FAILURE;
+			}
+			std::error_code error;
+			if (!piped && !std::filesystem::create_directories(record, error) && error)
+			{
+				std::cerr << "Recording directory error: " << record << std::endl;
+				return EXIT_FAILURE;
+			}
+			recorder = std::make_unique<lifegame::Grid>(static_cast<uint8_t>(dimension));
+			fps = 0;
+		}
+		bool fresh = false; // whether (or not) the dish has changed since its latest recording.
+
+		// Steps are requested ahead, then buffered so that their playback does not depend on the round-trip time.
+		client::PlaybackBuffer playback(fps, (std::max)(window, 1u));
+		bool born = false;
+		uint32_t requested = 0; // the latest requested generation.
+		uint32_t received = 0; // the latest received generation.
 
 		while (true)
 		{
@@ -60,15 +163,42 @@ int main(int argc, char* argv[])
 					if (connection->state() == network::event::Connection::State::Successfull)
 					{
 						std::cout << "Client connected." << std::endl;
+						auto request = !name.empty() ? lifegame::protocol::Request::Join : token != nullptr ? lifegame::protocol::Request::Resume : lifegame::protocol::Request::Create;
 						std::vector<network::PacketUnit> parameters;
+						parameters.push_back(static_cast<network::PacketUnit>(request));
 						parameters.push_back(rows);
 						parameters.push_back(columns);
 						parameters.push_back(ratio);
+						if (request == lifegame::protocol::Request::Join)
+						{
+							parameters.push_back(rate);
+							parameters.push_back(static_cast<network::PacketUnit>(rule));
+							parameters.push_back(static_cast<network::PacketUnit>(topology));
+							parameters.insert(parameters.end(), name.cbegin(), name.cend());
+						}
+						else
+						{
+							parameters.push_back(static_cast<network::PacketUnit>(rule));
+							parameters.push_back(static_cast<network::PacketUnit>(topology));
+							if (request == lifegame::protocol::Request::Resume)
+							{
+								lifegame::protocol::token(std::stoull(token), parameters);
+							}
+						}
 						if (!client.send(parameters.data(), static_cast<unsigned int>(parameters.size())))
 						{
 							std::cerr << "Client sending error: " << network::error::latest() << std::endl;
 							break;
 						}
+						if (name.empty() && rate > 0)
+						{
+							network::PacketUnit subscription[] = { static_cast<network::PacketUnit>(lifegame::protocol::Request::Subscribe), static_cast<network::PacketUnit>(rate) };
+							if (!client.send(subscription, sizeof(subscription)))
+							{
+								std::cerr << "Client sending error: " << network::error::latest() << std::endl;
+								break;
+							}
+						}
 					}
 					else
 					{
@@ -80,23 +210,73 @@ int main(int argc, char* argv[])
 				{
 					std::cout << "Client exchanging..." << std::endl;
 					auto exchange = event->as<network::event::Exchange>();
-					std::vector<network::PacketUnit> cells = exchange->packet();
-					dish.modify(cells);
-
-					// TODO display dish into a grid.
-					/*
-					for (auto cell : cells) {
-						std::cout << (int)cell << "_";
+					auto const& packet = exchange->packet();
+					lifegame::protocol::Reply reply;
+					uint32_t generation;
+					if (!lifegame::protocol::header(packet, reply, generation))
+					{
+						std::cerr << "Client reception error: invalid reply." << std::endl;
+						continue;
 					}
-					std::cout << "/" << std::endl;
-					*/
-
-					// Asking for advancing into next step.				
-					network::PacketUnit step(0);
-					if (!client.send(&step, sizeof(step)))
+					if (reply == lifegame::protocol::Reply::Seed)
 					{
-						std::cerr << "Client sending error: " << network::error::latest() << std::endl;
-						break;
+						uint8_t version;
+						uint64_t seed;
+						if (!lifegame::protocol::seed(packet, version, seed))
+						{
+							std::cerr << "Client reception error: invalid seed." << std::endl;
+						}
+						else if (version != lifegame::Random::VERSION)
+						{
+							// Unable to draw the same dish : asking for its cells instead.
+							std::cout << "Client seed version mismatch: " << static_cast<int>(version) << std::endl;
+							network::PacketUnit request = static_cast<network::PacketUnit>(lifegame::protocol::Request::Snapshot);
+							if (!client.send(&request, sizeof(request)))
+							{
+								std::cerr << "Client sending error: " << network::error::latest() << std::endl;
+								break;
+							}
+						}
+						else
+						{
+							dish = std::make_unique<lifegame::Dish>(rows, columns, ratio, seed);
+							born = true;
+							requested = received = played = generation;
+							fresh = true;
+						}
+					}
+					else if (reply == lifegame::protocol::Reply::Session)
+					{
+						uint64_t session;
+						if (!lifegame::protocol::token(packet, lifegame::protocol::REPLY_HEADER_SIZE, session))
+						{
+							std::cerr << "Client reception error: invalid session token." << std::endl;
+						}
+						else
+						{
+							std::cout << "Client session token: " << session << std::endl;
+						}
+					}
+					else if (reply == lifegame::protocol::Reply::Snapshot)
+					{
+						// A snapshot supersedes the buffered generations.
+						dish = lifegame::protocol::snapshot(packet);
+						if (!dish)
+						{
+							std::cerr << "Client reception error: invalid snapshot." << std::endl;
+							continue;
+						}
+						playback = client::PlaybackBuffer(fps, (std::max)(window, 1u));
+						born = true;
+						requested = received = played = generation;
+						fresh = true;
+					}
+					else if (lifegame::protocol::delta(reply))
+					{
+						// Steps requested before a snapshot are received after it : the delta is applied as it is, in any of its encodings, once played.
+						received = generation;
+						requested = (std::max)(requested, received);
+						playback.push(generation, std::vector<network::PacketUnit>(packet));
 					}
 				}
 				else if (event->is<network::event::Disconnection>())
@@ -106,6 +286,80 @@ int main(int argc, char* argv[])
 					break;
 				}
 			}
+
+			// Asking for advancing into next steps, unless the server pushes them.
+			while (born && rate == 0 && (requested - received) / stride < window && (requested - received) / stride + playback.size() < 2 * window)
+			{
+				network::PacketUnit step[] = { static_cast<network::PacketUnit>(lifegame::protocol::Request::Step), static_cast<network::PacketUnit>(stride) };
+				if (!client.send(step, stride > 1 ? sizeof(step) : 1))
+				{
+					std::cerr << "Client sending error: " << network::error::latest() << std::endl;
+					break;
+				}
+				requested += stride;
+			}
+
+			uint32_t generation;
+			std::vector<network::PacketUnit> delta;
+			if (playback.pop(client::PlaybackBuffer::Clock::now(), generation, delta))
+			{
+				std::cout << "Client playing generation: " << generation << std::endl;
+				if (!lifegame::protocol::delta(delta, *dish))
+				{
+					std::cerr << "Client reception error: invalid delta." << std::endl;
+				}
+
+				if (seek != nullptr && name.empty() && generation == std::stoul(seek))
+				{
+					std::string seeked(seek);
+					auto target = static_cast<uint32_t>(std::stoul(seeked.substr(seeked.find(',') + 1)));
+					std::cout << "Client seeking generation: " << target << std::endl;
+					std::vector<network::PacketUnit> request;
+					request.push_back(static_cast<network::PacketUnit>(lifegame::protocol::Request::Seek));
+					for (int shift = 24; shift >= 0; shift -= 8)
+					{
+						request.push_back(static_cast<network::PacketUnit>(target >> shift));
+					}
+					seek = nullptr;
+					if (!client.send(request.data(), static_cast<unsigned int>(request.size())))
+					{
+						std::cerr << "Client sending error: " << network::error::latest() << std::endl;
+						break;
+					}
+				}
+				played = generation;
+				fresh = true;
+			}
+
+			// Drawing the latest played generation, at most at the display rate.
+			if (grid != nullptr && dish != nullptr)
+			{
+				grid->draw(*dish, played, lifegame::Grid::Clock::now());
+			}
+
+			// Recording every played generation, from the cells changed since the previous one.
+			if (recorder != nullptr && dish != nullptr && fresh)
+			{
+				fresh = false;
+				recorder->rasterise(*dish);
+				if (piped)
+				{
+					recorder->write(output);
+					output.flush();
+				}
+				else
+				{
+					std::ostringstream path;
+					path << record << "/" << std::setw(8) << std::setfill('0') << played << ".ppm";
+					std::ofstream image(path.str(), std::ios::binary);
+					recorder->write(image);
+					if (!image)
+					{
+						std::cerr << "Recording error: " << path.str() << std::endl;
+						recorder.reset();
+					}
+				}
+			}
 		}
 	}
 
@@ -0,0 +1,67 @@
+#include <client/PlaybackBuffer.hpp>
+#include <assert.h>
+
+namespace client
+{
+	PlaybackBuffer::PlaybackBuffer(unsigned int rate, size_t depth) :
+		period_(rate > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / rate : Clock::duration::zero()),
+		depth_(depth > 0 ? depth : 1)
+	{
+	}
+
+	void PlaybackBuffer::push(uint32_t generation, std::vector<uint8_t>&& delta)
+	{
+		// TCP keeps replies in order : a generation older than the latest one is a duplicate.
+		assert(frames_.empty() || frames_.back().generation < generation);
+		frames_.push_back(Frame{ generation, std::move(delta) });
+	}
+
+	bool PlaybackBuffer::pop(Clock::time_point now, uint32_t& generation, std::vector<uint8_t>& delta)
+	{
+		if (!playing_)
+		{
+			if (frames_.size() < depth_)
+			{
+				return false;
+			}
+			playing_ = true;
+			due_ = now;
+		}
+
+		if (now < due_)
+		{
+			return false;
+		}
+
+		if (frames_.empty())
+		{
+			// Pausing until the buffer is filled again, rather than stuttering frame after frame.
+			playing_ = false;
+			++underruns_;
+			return false;
+		}
+
+		Frame& frame = frames_.front();
+		generation = frame.generation;
+		delta = std::move(frame.delta);
+		frames_.pop_front();
+
+		// Keep a steady pace, without bursting to catch up a late caller.
+		due_ += period_;
+		if (due_ < now)
+		{
+			due_ = now;
+		}
+		return true;
+	}
+
+	size_t PlaybackBuffer::size() const
+	{
+		return frames_.size();
+	}
+
+	unsigned int PlaybackBuffer::underruns() const
+	{
+		return underruns_;
+	}
+}
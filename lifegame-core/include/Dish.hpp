@@ -1,12 +1,86 @@
 #pragma once
 
 #include <Cell.hpp>
+#include <Rule.hpp>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace lifegame
 {
 
+	/**
+	* The engines computing the generations of a dish, giving the same cells.
+	*
+	* * 'Cells' : each cell counts its alive neighbours, & its next state is read from the rule table.
+	* * 'Blocks' : each 2 x 2 block of cells is packed with its neighbours (a 4 x 4 block, 16 bits) into an index,
+	* & the next states of the 4 cells are read at once from a 65536 entries table, built once per rule.
+	* * 'Tiles' : the dish is cut into bands of rows fitting into the L1 data cache, each band living several generations before the next one,
+	* from its rows & a halo of rows as wide as the generations (temporal blocking).
+	*/
+	enum class Engine : uint8_t
+	{
+		Cells = 0,
+		Blocks = 1,
+		Tiles = 2,
+	};
+
+	/**
+	* Retrieve the name of an engine.
+	*
+	* @param engine the engine.
+	* @return the name, in lowercase.
+	*/
+	const char* name(const Engine engine);
+
+	/**
+	* Retrieve an engine by its name.
+	*
+	* @param name the name, in lowercase.
+	* @param engine the engine.
+	* @return whether (or not) the name is the name of an engine.
+	*/
+	bool engine(const std::string& name, Engine& engine);
+
+	/**
+	* The topologies of a dish : what lies beyond its edges.
+	*
+	* * 'Bounded' : dead cells, patterns reaching an edge are distorted.
+	* * 'Torus' : the opposite edges, patterns reaching an edge go on from the opposite one.
+	*/
+	enum class Topology : uint8_t
+	{
+		Bounded = 0,
+		Torus = 1,
+	};
+
+	/**
+	* The number of topologies.
+	*/
+	static const uint8_t TOPOLOGIES = 2;
+
+	/**
+	* Retrieve the name of a topology.
+	*
+	* @param topology the topology.
+	* @return the name, in lowercase.
+	*/
+	const char* name(const Topology topology);
+
+	/**
+	* Retrieve a topology by its name.
+	*
+	* @param name the name, in lowercase.
+	* @param topology the topology.
+	* @return whether (or not) the name is the name of a topology.
+	*/
+	bool topology(const std::string& name, Topology& topology);
+
+	/**
+	* The most rows or columns of a dish : its immutable border must fit into the same 8 bits.
+	*/
+	static const uint8_t DIMENSION = 253;
+
 	/**
 	* A Petri dish, filled with alive & dead cells.
 	**/
@@ -17,11 +91,21 @@ namespace lifegame
 		/**
 		* Create a new dish with given sizes & a given ratio of alive cells.
 		*
-		* @param rows the dish height.
-		* @param columns the dish width.
+		* @param rows the dish height, in [1, DIMENSION].
+		* @param columns the dish width, in [1, DIMENSION].
 		* @param aliveCellsRatio the dish ratio of alive cells.
 		*/
 		Dish(const uint8_t rows, const uint8_t columns, const uint8_t aliveCellsRatio);
+		/**
+		* Create a new dish with given sizes & a given ratio of alive cells, drawn from a given seed.
+		* The same parameters always give the same dish.
+		*
+		* @param rows the dish height, in [1, DIMENSION].
+		* @param columns the dish width, in [1, DIMENSION].
+		* @param aliveCellsRatio the dish ratio of alive cells.
+		* @param seed the seed of the cells draw.
+		*/
+		Dish(const uint8_t rows, const uint8_t columns, const uint8_t aliveCellsRatio, const uint64_t seed);
 		Dish(const Dish& dish);
 		Dish& operator=(const Dish& dish);
 		Dish(Dish&& dish) noexcept;
@@ -30,6 +114,14 @@ namespace lifegame
 
 		uint8_t rows() const;
 		uint8_t columns() const;
+		Topology topology() const;
+		/**
+		* Set the topology of the dish, bounded by default.
+		* The border of a torus holds a copy of the opposite edges (the halo), refreshed before each generation.
+		*
+		* @param topology the topology.
+		*/
+		void topology(const Topology topology);
 		void cells(std::vector<uint8_t>& cells) const;
 		/**
 		* Retrieve a copy of a cell in the dish.
@@ -49,21 +141,111 @@ namespace lifegame
 		*/
 		uint8_t alive(const uint8_t row, const uint8_t column) const;
 		/**
-		* Let the dish live & cells become alive or dead.
+		* Let the dish live by the Life rule & cells become alive or dead.
 		* 
 		* @param the cells whom state has changed : first 'row' coordinate, second 'column' coordinate, third cell state.
 		*/
 		void live(std::vector<uint8_t>& cells);
 		/**
+		* Let the dish live by a given rule & cells become alive or dead.
+		* Every cell lives from the same generation : the cells whom state has changed are only applied once all are computed.
+		*
+		* @param the cells whom state has changed : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param rule the rule.
+		*/
+		void live(std::vector<uint8_t>& cells, const Rule rule);
+		/**
+		* Let the dish live by a given rule, computed by a given engine.
+		* Every engine gives the same cells, in the same order : row after row, column after column.
+		*
+		* @param the cells whom state has changed : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param rule the rule.
+		* @param engine the engine.
+		*/
+		void live(std::vector<uint8_t>& cells, const Rule rule, const Engine engine);
+		/**
+		* Let the dish live several generations by a given rule, computed by a given engine.
+		*
+		* @param the cells whom state differs after the generations : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param rule the rule.
+		* @param engine the engine.
+		* @param generations the number of generations, at least 1.
+		*/
+		void live(std::vector<uint8_t>& cells, const Rule rule, const Engine engine, const unsigned int generations);
+		/**
+		* Compute the next states of a range of rows by a given rule, without letting the dish live : the cells are applied later on by 'modify'.
+		* The dish is only read, so that ranges of rows can be computed at once by several threads, & the border rows can be set meanwhile.
+		* The rows above & below the range are read as they are, the border rows included : a strip of a larger dish reads its halo from them.
+		* Beyond the side edges of a torus, the opposite columns are read.
+		*
+		* @param the cells whom state changes : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param rule the rule.
+		* @param first the first row of the range, at least 1.
+		* @param last the row after the range, at most 'rows() - 1'.
+		*/
+		void next(std::vector<uint8_t>& cells, const Rule rule, const uint8_t first, const uint8_t last) const;
+		/**
 		* Modify the dish with given cells.
+		* The cells are validated at once, then applied without any check per cell : invalid cells leave the dish unchanged.
 		*
 		* @param the cells to apply to the dish : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param offset the offset of the first cell.
+		* @return whether (or not) the cells are valid : whole triples, inside the immutable border, of states '0' or '1'.
+		*/
+		bool modify(const std::vector<uint8_t>& cells, const size_t offset = 0);
+		/**
+		* Flip the states of the living cells set in packed bits.
+		* The bits are validated at once, then applied without any check per cell : invalid bits leave the dish unchanged.
+		*
+		* @param bits the packed cells to flip, laid out as by 'pack'.
+		* @param offset the offset of the bits.
+		* @return whether (or not) the bits are valid : exactly one bit per living cell, the padding bits unset.
+		*/
+		bool modifyBits(const std::vector<uint8_t>& bits, const size_t offset = 0);
+		/**
+		* Flip the states of the living cells at given runs.
+		* The living cells are numbered row after row, column after column : each run is the number of unchanged cells before the next flipped one,
+		* as a variable length integer (7 bits per byte, the lowest first, the highest bit set on every byte but the last).
+		* The runs are validated at once, then applied without any check per cell : invalid runs leave the dish unchanged.
+		*
+		* @param runs the runs.
+		* @param offset the offset of the first run.
+		* @return whether (or not) the runs are valid : whole integers, reaching living cells only.
+		*/
+		bool modifyRuns(const std::vector<uint8_t>& runs, const size_t offset = 0);
+		/**
+		* Pack the states of the living cells (the ones inside the immutable border) as bits.
+		*
+		* @param bits the packed states, row after row : 8 cells per byte, the first cell in the lowest bit.
+		*/
+		void pack(std::vector<uint8_t>& bits) const;
+		/**
+		* Set the states of the living cells from packed bits.
+		*
+		* @param bits the packed states, as given by 'pack'.
 		*/
-		void modify(const std::vector<uint8_t>& cells);
+		void unpack(const std::vector<uint8_t>& bits);
+		/**
+		* Pack the states of the living cells of a row as bits, appended to the given ones.
+		*
+		* @param row the row, the border rows included.
+		* @param bits the packed states : 8 cells per byte, the first cell in the lowest bit.
+		*/
+		void pack(const uint8_t row, std::vector<uint8_t>& bits) const;
+		/**
+		* Set the states of the living cells of a row from packed bits.
+		* Unlike the other cells, the border rows can be set : they hold the halo of a strip of a larger dish.
+		*
+		* @param row the row, the border rows included.
+		* @param bits the packed states, as given by 'pack'.
+		* @param offset the offset of the states in the bits.
+		*/
+		void unpack(const uint8_t row, const std::vector<uint8_t>& bits, const size_t offset);
 
 	private:
 		uint8_t rows_;
 		uint8_t columns_;
+		Topology topology_ = Topology::Bounded;
 		/*
 		* Modern C++ will use stdd:vector and/or std:array.
 		* Raw pointers are used here for self-teaching goals.
@@ -71,23 +253,40 @@ namespace lifegame
 		Cell** dish_;
 
 		/**
-		* Set the state of a cell in the dish.
-		* A value > 0 stands for an alive cell, a value = 0 stand for a dead cell.
+		* Refresh the halo of a torus from the opposite edges : whole rows first, then both border columns of every row, corners included.
+		*/
+		void wrap();
+		/**
+		* Let the dish live by a rule resolved at compile time, cell by cell : each rule has its own kernel.
+		*
+		* @param the cells whom state has changed : first 'row' coordinate, second 'column' coordinate, third cell state.
+		*/
+		template <typename Kernel>
+		void liveCells(std::vector<uint8_t>& cells);
+		/**
+		* Let the dish live by a rule resolved at compile time, 2 x 2 cells at a time : each rule has its own kernel & its own table.
+		*
+		* @param the cells whom state has changed : first 'row' coordinate, second 'column' coordinate, third cell state.
+		*/
+		template <typename Kernel>
+		void liveBlocks(std::vector<uint8_t>& cells);
+		/**
+		* Let the dish live several generations by a rule resolved at compile time, band after band : each rule has its own kernel.
 		*
-		* @param row the "row" coordinate (= y) of the cell.
-		* @param column the "column" coordinate (= x) of the cell.
-		* @param state the state of the cell.
-		* @return whether the cell state has changed.
+		* @param the cells whom state differs after the generations : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param generations the number of generations.
 		*/
-		bool cell(const uint8_t row, const uint8_t column, const uint8_t state);
+		template <typename Kernel>
+		void liveTiles(std::vector<uint8_t>& cells, const unsigned int generations);
 		/**
-		* Let a cell live & become alive or dead.
+		* Compute the next states of a range of rows by a rule resolved at compile time : each rule has its own kernel.
 		*
-		* @param row the "row" coordinate (= y) of the cell.
-		* @param column the "column" coordinate (= x) of the cell.
-		* @param state the new state of the cell.
+		* @param the cells whom state changes : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param first the first row of the range.
+		* @param last the row after the range.
 		*/
-		uint8_t live(const uint8_t row, const uint8_t column);
+		template <typename Kernel>
+		void nextRows(std::vector<uint8_t>& cells, const uint8_t first, const uint8_t last) const;
 
 	};
 
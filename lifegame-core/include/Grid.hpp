@@ -1,30 +1,129 @@
 #pragma once
 
 #include <Dish.hpp>
-///#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
 
-// TODO Display dish as a grid
 namespace lifegame
 {
 
 	/**
-	* A representation of a Petri dish as a grid.
+	* A representation of a Petri dish as a grid, drawn into a terminal or rasterised into an RGB framebuffer.
+	*
+	* In a terminal, each character stands for 2 cells, one above the other, as a half block : the dish fits into half as many lines.
+	* A frame only draws the characters whose cells have changed since the previous frame, reached by ANSI cursor moves,
+	* & the whole frame is written at once. Frames are drawn at most at a given rate : the generations lived in between are drawn together.
+	*
+	* In a framebuffer, each cell is a square of pixels : only the squares of the cells changed since the previous rasterisation are painted,
+	* & the framebuffer is written as an image, one per generation to record.
 	*/
-	class Grid //: public sf::Drawable, public sf::Transformable
+	class Grid
 	{
+
 	public:
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		* Create a new grid drawn into a terminal.
+		* The grid is drawn on the alternate screen of the terminal, left when the grid is destroyed.
+		*
+		* @param terminal the output of the terminal.
+		* @param fps the most frames drawn per second, '0' for no limit.
+		*/
+		Grid(std::ostream& terminal, const unsigned int fps);
+		/**
+		* Create a new grid rasterised into an RGB framebuffer.
+		*
+		* @param cellDimension the side of the square of each cell, in pixels.
+		*/
+		explicit Grid(const uint8_t cellDimension);
+		Grid(const Grid& grid) = delete;
+		Grid& operator=(const Grid& grid) = delete;
+		~Grid();
+
+		/**
+		* Draw a dish, if a frame is due : only the cells changed since the previous frame are drawn.
+		* A dish of other sizes than the previous one is drawn whole.
+		*
+		* @param dish the dish.
+		* @param generation the generation of the dish, drawn below it.
+		* @param now the current time.
+		* @return whether (or not) a frame has been drawn.
+		*/
+		bool draw(const Dish& dish, const uint32_t generation, const Clock::time_point now);
+
+		/**
+		* Draw the whole dish on the next frame, once the terminal has been written by others.
+		*/
+		void invalidate();
+
+		/**
+		* Rasterise a dish into the framebuffer : only the cells changed since the previous rasterisation are painted.
+		* A dish of other sizes than the previous one is painted whole.
+		*
+		* @param dish the dish.
+		*/
+		void rasterise(const Dish& dish);
+
 		/**
-		* Create a new grid with a given dish & a given dimension for cells.
+		* Retrieve the framebuffer : rows of pixels from top to bottom, each pixel as red, green & blue bytes.
 		*
-		* @param dish the associated dish.
-		* @param cellDimension the dimension for cells.
+		* @return the framebuffer.
 		*/
-		Grid(const Dish& dish, const uint8_t cellDimension);
+		const std::vector<uint8_t>& framebuffer() const;
+		unsigned int width() const;
+		unsigned int height() const;
+
+		/**
+		* Write the framebuffer as a binary PPM image (P6).
+		* Images written one after the other form a stream, as read from a pipe by video encoders.
+		*
+		* @param output the output.
+		*/
+		void write(std::ostream& output) const;
 
 	private:
-		Dish dish_;
-		//sf::VertexArray vertices_; // the vertices used to draw the grid.
-		//virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const;
+		std::ostream* terminal_ = nullptr;
+		Clock::duration period_ = Clock::duration::zero();
+		Clock::time_point due_;
+		bool started_ = false;
+		bool invalid_ = true;
+		uint8_t rows_ = 0; // the rows of the drawn dish, its border excluded.
+		uint8_t columns_ = 0; // the columns of the drawn dish, its border excluded.
+		std::vector<uint8_t> drawn_; // the states of the drawn cells, packed as by 'Dish::pack'.
+		std::vector<uint8_t> states_; // the states of the cells to draw or to rasterise, packed as by 'Dish::pack'.
+		std::string frame_; // the cursor moves & the characters of a frame.
+		uint8_t cellDimension_ = 1;
+		unsigned int width_ = 0; // the width of the framebuffer, in pixels.
+		unsigned int height_ = 0; // the height of the framebuffer, in pixels.
+		std::vector<uint8_t> rasterised_; // the states of the rasterised cells, packed as by 'Dish::pack'.
+		std::vector<uint8_t> framebuffer_;
+
+		/**
+		* Append the character of 2 cells, one above the other, to the frame.
+		*
+		* @param line the line of the character.
+		* @param column the column of the character.
+		*/
+		void character(const unsigned int line, const unsigned int column);
+		/**
+		* Append a cursor move to the frame.
+		*
+		* @param line the line, from 0.
+		* @param column the column, from 0.
+		*/
+		void move(const unsigned int line, const unsigned int column);
+		/**
+		* Paint the square of a cell into the framebuffer.
+		*
+		* @param row the row of the cell, from 0.
+		* @param column the column of the cell, from 0.
+		* @param alive the state of the cell.
+		*/
+		void paint(const size_t row, const size_t column, const bool alive);
 
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lifegame
+{
+	namespace metrics
+	{
+		/**
+		* The maximum numbers of counters & histograms.
+		*/
+		static const size_t COUNTERS = 64;
+		static const size_t HISTOGRAMS = 32;
+
+		/**
+		* The number of histogram buckets : a value 'v' > 0 falls into the bucket 'log2(v) + 1', '0' into the bucket '0'.
+		*/
+		static const size_t BUCKETS = 65;
+
+		/**
+		* A named counter, summed over every thread.
+		*
+		* Each thread adds to its own copy, without lock nor atomic read-modify-write : the copies are only read when collected.
+		* Counters are meant to be static, created once per name.
+		**/
+		class Counter
+		{
+
+		public:
+			/**
+			* Create a new counter.
+			*
+			* @param name the counter name.
+			*/
+			explicit Counter(const char* name);
+
+			/**
+			* Add to the counter.
+			*
+			* @param value the value to add, negative for a gauge going down.
+			*/
+			void add(const int64_t value = 1);
+
+		private:
+			size_t index_;
+
+		};
+
+		/**
+		* A named histogram of values, with power-of-two buckets, merged over every thread.
+		**/
+		class Histogram
+		{
+
+		public:
+			/**
+			* Create a new histogram.
+			*
+			* @param name the histogram name.
+			*/
+			explicit Histogram(const char* name);
+
+			/**
+			* Record a value.
+			*
+			* @param value the value.
+			*/
+			void record(const uint64_t value);
+
+		private:
+			size_t index_;
+
+		};
+
+		/**
+		* The collected value of a counter.
+		*/
+		struct CounterValue
+		{
+			std::string name;
+			int64_t value = 0;
+		};
+
+		/**
+		* The collected values of a histogram.
+		*/
+		struct HistogramValue
+		{
+			std::string name;
+			uint64_t count = 0;
+			uint64_t sum = 0;
+			uint64_t buckets[BUCKETS] = {};
+
+			/**
+			* Estimate a quantile.
+			*
+			* @param quantile the quantile, in [0, 1].
+			* @return the upper bound of the bucket holding the quantile, '0' without values.
+			*/
+			uint64_t quantile(const double quantile) const;
+		};
+
+		/**
+		* Collect the counters & histograms over every thread, including the ended ones.
+		*
+		* @param counters the counters.
+		* @param histograms the histograms.
+		*/
+		void collect(std::vector<CounterValue>& counters, std::vector<HistogramValue>& histograms);
+
+		/**
+		* Write collected metrics as text : one 'name value' line per counter,
+		* then one 'name count=... mean=... p50=... p99=... p999=...' line per histogram.
+		*
+		* @param counters the counters.
+		* @param histograms the histograms.
+		* @param text the text.
+		*/
+		void write(const std::vector<CounterValue>& counters, const std::vector<HistogramValue>& histograms, std::string& text);
+	}
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <Dish.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lifegame
+{
+	namespace protocol
+	{
+		/**
+		* The requests a client sends to the server, identified by their first byte.
+		*
+		* * 'Step' : [Step, generations], advance the dish by the given generations, by one when omitted : a single delta reaches the last one.
+		* * 'Create' : [Create, rows, columns, ratio, rule, topology], create the dish, living by the given rule (see 'Rule') on the given topology (see 'Topology').
+		* * 'Subscribe' : [Subscribe, rate], let the server advance the dish 'rate' times per second & push each generation.
+		* * 'Unsubscribe' : [Unsubscribe], go back to client-driven steps.
+		* * 'Snapshot' : [Snapshot], ask for every cell of the dish, when it can't be built from its seed.
+		* * 'Join' : [Join, rows, columns, ratio, rate, rule, topology, name...], watch the shared dish of the given name, created with the given parameters if needed.
+		* * 'Resume' : [Resume, rows, columns, ratio, rule, topology, token (8 bytes, big endian)], get back the private dish of the given session token, or create it with the given parameters if unknown.
+		* * 'Seek' : [Seek, generation (4 bytes, big endian)], rewind the private dish to a logged generation, sent back as a snapshot.
+		* * 'Stats' : [Stats], ask for the server metrics & the client traffic.
+		*/
+		enum class Request : uint8_t
+		{
+			Step = 0,
+			Create = 1,
+			Subscribe = 2,
+			Unsubscribe = 3,
+			Snapshot = 4,
+			Join = 5,
+			Resume = 6,
+			Seek = 7,
+			Stats = 8,
+		};
+
+		/**
+		* The replies the server sends to a client, starting with a header : [Reply, generation (4 bytes, big endian)].
+		*
+		* * 'Snapshot' : the header, then [rows, columns, states...], every cell of the dish at the given generation (see 'Dish::pack').
+		* * 'Delta' : the header, then the cells whose state has changed to reach the given generation, from the previous generation sent.
+		* * 'Seed' : the header, then [version, seed (8 bytes, big endian)], to build the dish from (see 'Random').
+		* * 'Session' : the header, then [token (8 bytes, big endian)], to resume the private dish with, after a server restart.
+		* * 'Stats' : the header, then the metrics as text, one 'name value...' line per metric (see 'metrics::write').
+		* * 'Bitmap' : the header, then a delta as the packed bits of the living cells whose state flips (see 'Dish::modifyBits').
+		* * 'Runs' : the header, then a delta as the runs of unchanged living cells between the ones whose state flips (see 'Dish::modifyRuns').
+		*
+		* Delta cells are sent as triples : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* A delta is sent in the smallest of its encodings : triples for a few cells, runs for scattered cells, a bitmap for many cells.
+		*/
+		enum class Reply : uint8_t
+		{
+			Snapshot = 0,
+			Delta = 1,
+			Seed = 2,
+			Session = 3,
+			Stats = 4,
+			Bitmap = 5,
+			Runs = 6,
+		};
+
+		static const unsigned int REPLY_HEADER_SIZE = 1 + sizeof(uint32_t);
+
+		/**
+		* Append a reply header to a packet.
+		*
+		* @param reply the reply type.
+		* @param generation the generation of the dish.
+		* @param packet the packet.
+		*/
+		void header(const Reply reply, const uint32_t generation, std::vector<uint8_t>& packet);
+
+		/**
+		* Read the header of a reply.
+		*
+		* @param packet the packet.
+		* @param reply the reply type.
+		* @param generation the generation of the dish.
+		* @return whether (or not) the packet starts with a valid header.
+		*/
+		bool header(const std::vector<uint8_t>& packet, Reply& reply, uint32_t& generation);
+
+		/**
+		* Tell whether a reply is a delta, in any of its encodings.
+		*
+		* @param reply the reply type.
+		* @return whether (or not) the reply is a 'Delta', a 'Bitmap' or a 'Runs' reply.
+		*/
+		bool delta(const Reply reply);
+
+		/**
+		* Encode a 'Delta' reply in its smallest encoding.
+		* The delta cells flip their state, row after row : they are encoded by their position only.
+		*
+		* @param dish the dish the delta applies to, giving its sizes.
+		* @param delta the 'Delta' reply.
+		* @param packet the packet, to which the 'Delta', 'Bitmap' or 'Runs' reply is appended.
+		*/
+		void delta(const Dish& dish, const std::vector<uint8_t>& delta, std::vector<uint8_t>& packet);
+
+		/**
+		* Apply a delta reply, in any of its encodings, to a dish.
+		*
+		* @param packet the packet.
+		* @param dish the dish.
+		* @return whether (or not) the packet holds a valid delta for the dish : an invalid one leaves the dish unchanged.
+		*/
+		bool delta(const std::vector<uint8_t>& packet, Dish& dish);
+
+		/**
+		* Append a seed to a packet.
+		*
+		* @param version the version of the generator drawing the dish from the seed.
+		* @param seed the seed.
+		* @param packet the packet.
+		*/
+		void seed(const uint8_t version, const uint64_t seed, std::vector<uint8_t>& packet);
+
+		/**
+		* Read the seed of a 'Seed' reply.
+		*
+		* @param packet the packet.
+		* @param version the version of the generator drawing the dish from the seed.
+		* @param seed the seed.
+		* @return whether (or not) the packet holds a seed.
+		*/
+		bool seed(const std::vector<uint8_t>& packet, uint8_t& version, uint64_t& seed);
+
+		/**
+		* Append a session token to a packet.
+		*
+		* @param token the session token.
+		* @param packet the packet.
+		*/
+		void token(const uint64_t token, std::vector<uint8_t>& packet);
+
+		/**
+		* Read the session token ending a 'Session' reply or a 'Resume' request.
+		*
+		* @param packet the packet.
+		* @param offset the position of the token in the packet.
+		* @param token the session token.
+		* @return whether (or not) the packet ends with a token at the given position.
+		*/
+		bool token(const std::vector<uint8_t>& packet, const size_t offset, uint64_t& token);
+
+		/**
+		* Append the cells of a dish to a packet.
+		*
+		* @param dish the dish.
+		* @param packet the packet.
+		*/
+		void snapshot(const Dish& dish, std::vector<uint8_t>& packet);
+
+		/**
+		* Build a dish from the cells of a 'Snapshot' reply.
+		*
+		* @param packet the packet.
+		* @return the dish, 'nullptr' if the packet does not hold a dish.
+		*/
+		std::unique_ptr<Dish> snapshot(const std::vector<uint8_t>& packet);
+	}
+}
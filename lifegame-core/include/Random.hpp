@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace lifegame
+{
+
+	/**
+	* A fast pseudo-random generator (xoshiro256**), reproducible from a 64-bit seed on every platform.
+	**/
+	class Random
+	{
+
+	public:
+		/**
+		* The version of the generator : two versions may draw different numbers from the same seed.
+		*/
+		static const uint8_t VERSION = 1;
+
+		/**
+		* Create a new generator.
+		*
+		* @param seed the seed, expanded into the generator state.
+		*/
+		explicit Random(const uint64_t seed);
+
+		/**
+		* Draw 64 random bits.
+		*
+		* @return the drawn bits.
+		*/
+		uint64_t next();
+
+		/**
+		* Draw 64 random bits, each one set with a given probability.
+		*
+		* @param probability the probability of a set bit, in 256ths.
+		* @return the drawn bits.
+		*/
+		uint64_t bernoulli(const uint16_t probability);
+
+	private:
+		uint64_t state_[4];
+
+	};
+
+}
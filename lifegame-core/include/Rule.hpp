@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace lifegame
+{
+
+	/**
+	* The Life-like rules a dish can live by, as sent by clients at the dish creation.
+	*
+	* * 'Life' : B3/S23, the Conway's Game of Life.
+	* * 'HighLife' : B36/S23, with a replicator.
+	* * 'DayAndNight' : B3678/S34678, symmetric between alive & dead cells.
+	* * 'Seeds' : B2/S, every cell dies at once.
+	*/
+	enum class Rule : uint8_t
+	{
+		Life = 0,
+		HighLife = 1,
+		DayAndNight = 2,
+		Seeds = 3,
+	};
+
+	/**
+	* The number of rules.
+	*/
+	static const uint8_t RULES = 4;
+
+	/**
+	* Retrieve the birth & survival neighbour counts of a rule, as bits : the birth counts in the lowest 9 bits, the survival counts in the next 9 bits.
+	*
+	* @param rule the rule.
+	* @return the neighbour counts.
+	*/
+	uint32_t code(const Rule rule);
+
+	/**
+	* Retrieve the name of a rule.
+	*
+	* @param rule the rule.
+	* @return the name, in lowercase.
+	*/
+	const char* name(const Rule rule);
+
+	/**
+	* Retrieve a rule by its name.
+	*
+	* @param name the name, in lowercase.
+	* @param rule the rule.
+	* @return whether (or not) the name is the name of a rule.
+	*/
+	bool rule(const std::string& name, Rule& rule);
+
+	namespace rules
+	{
+		/**
+		* Set the bits of given neighbour counts.
+		*/
+		template <typename... Counts>
+		constexpr uint16_t counts(const Counts... neighbours)
+		{
+			return static_cast<uint16_t>((0 | ... | (1 << neighbours)));
+		}
+
+		/**
+		* A Life-like rule, resolved at compile time : the next state of a cell is read from a table, by its state & its alive neighbours.
+		*
+		* @param Birth the neighbour counts giving birth to a dead cell, as bits.
+		* @param Survival the neighbour counts keeping an alive cell alive, as bits.
+		**/
+		template <uint16_t Birth, uint16_t Survival>
+		struct LifeLike
+		{
+			static constexpr uint16_t BIRTH = Birth;
+			static constexpr uint16_t SURVIVAL = Survival;
+			static constexpr uint32_t CODE = Birth | (static_cast<uint32_t>(Survival) << 9);
+
+			/**
+			* The next states : first the 9 dead cell states by neighbour count, then the 9 alive cell states.
+			*/
+			static constexpr std::array<uint8_t, 18> TABLE = [] {
+				std::array<uint8_t, 18> table{};
+				for (unsigned int neighbours = 0; neighbours < 9; ++neighbours)
+				{
+					table[neighbours] = (Birth >> neighbours) & 1;
+					table[9 + neighbours] = (Survival >> neighbours) & 1;
+				}
+				return table;
+			}();
+
+			/**
+			* Let a cell live.
+			*
+			* @param alive the state of the cell, '0' or '1'.
+			* @param neighbours the number of alive neighbours.
+			* @return the next state of the cell.
+			*/
+			static constexpr uint8_t next(const uint8_t alive, const uint8_t neighbours)
+			{
+				return TABLE[alive * 9 + neighbours];
+			}
+		};
+
+		using Life = LifeLike<counts(3), counts(2, 3)>;
+		using HighLife = LifeLike<counts(3, 6), counts(2, 3)>;
+		using DayAndNight = LifeLike<counts(3, 6, 7, 8), counts(3, 4, 6, 7, 8)>;
+		using Seeds = LifeLike<counts(2), counts()>;
+	}
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+* Trace points are compiled in when 'LIFEGAME_TRACING' is defined, & compiled out otherwise.
+*
+* 'LIFEGAME_TRACE(name)' traces the enclosing scope as a span named by a string literal.
+*/
+#if defined(LIFEGAME_TRACING)
+#define LIFEGAME_TRACE_JOIN(a, b) a##b
+#define LIFEGAME_TRACE_SPAN(name, line) lifegame::trace::Span LIFEGAME_TRACE_JOIN(span, line)(name)
+#define LIFEGAME_TRACE(name) LIFEGAME_TRACE_SPAN(name, __LINE__)
+#else
+#define LIFEGAME_TRACE(name)
+#endif
+
+namespace lifegame
+{
+	namespace trace
+	{
+		/**
+		* Whether (or not) the trace points are compiled in.
+		*/
+#if defined(LIFEGAME_TRACING)
+		static const bool ENABLED = true;
+#else
+		static const bool ENABLED = false;
+#endif
+
+		/**
+		* The number of spans kept by each thread : the oldest ones are overwritten.
+		*/
+		static const size_t CAPACITY = 64 * 1024;
+
+		/**
+		* A traced scope, recorded into the ring buffer of its thread when it ends.
+		**/
+		class Span
+		{
+
+		public:
+			/**
+			* Start a span.
+			*
+			* @param name the span name, a string literal.
+			*/
+			explicit Span(const char* name);
+			Span(const Span& span) = delete;
+			Span& operator=(const Span& span) = delete;
+			~Span();
+
+		private:
+			const char* name_;
+			std::chrono::steady_clock::time_point start_;
+
+		};
+
+		/**
+		* Record a span.
+		*
+		* @param name the span name, a string literal.
+		* @param start the start of the span.
+		* @param end the end of the span.
+		*/
+		void record(const char* name, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end);
+
+		/**
+		* Write the spans of every thread in the Chrome trace event format (see 'chrome://tracing' or 'ui.perfetto.dev').
+		*
+		* Spans recorded while dumping may be missing or mixed up.
+		*
+		* @param path the path of the file.
+		* @return whether (or not) the file has been written.
+		*/
+		bool dump(const std::string& path);
+	}
+}
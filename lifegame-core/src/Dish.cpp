@@ -1,20 +1,90 @@
 #include <Dish.hpp>
+#include <Random.hpp>
+#include <Trace.hpp>
+#include <algorithm>
 #include <assert.h>
+#include <cstring>
 #include <iostream>
 #include <random>
+#include <utility>
 
 using namespace std;
 
 namespace lifegame
 {
 
+	/**
+	* Draw a seed from the system random device.
+	**/
+	static uint64_t entropy()
+	{
+		random_device device;
+		return (static_cast<uint64_t>(device()) << 32) | device();
+	}
+
+	const char* name(const Engine engine)
+	{
+		switch (engine)
+		{
+		case Engine::Cells: return "cells";
+		case Engine::Blocks: return "blocks";
+		case Engine::Tiles: return "tiles";
+		}
+		return "?";
+	}
+
+	bool engine(const std::string& name, Engine& engine)
+	{
+		for (auto candidate : { Engine::Cells, Engine::Blocks, Engine::Tiles })
+		{
+			if (name == lifegame::name(candidate))
+			{
+				engine = candidate;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	const char* name(const Topology topology)
+	{
+		switch (topology)
+		{
+		case Topology::Bounded: return "bounded";
+		case Topology::Torus: return "torus";
+		}
+		return "?";
+	}
+
+	bool topology(const std::string& name, Topology& topology)
+	{
+		for (auto candidate : { Topology::Bounded, Topology::Torus })
+		{
+			if (name == lifegame::name(candidate))
+			{
+				topology = candidate;
+				return true;
+			}
+		}
+		return false;
+	}
+
 	/**
 	* Create a new dish with given sizes & a given ratio of alive cells.
+	**/
+	Dish::Dish(const uint8_t rows, const uint8_t columns, const uint8_t aliveCellsRatio) : Dish(rows, columns, aliveCellsRatio, entropy())
+	{
+	}
+
+	/**
+	* Create a new dish with given sizes & a given ratio of alive cells, drawn from a given seed.
 	*
 	* 2 units of height & 2 units of width are added to the dish. They will contains immutable cells used for transition state computation.
+	* Each living cell is alive with a probability of the given ratio (in 256ths) : cells are drawn 64 at a time, from a word of random bits.
 	**/
-	Dish::Dish(const uint8_t rows, const uint8_t columns, const uint8_t aliveCellsRatio) : rows_(rows + 2), columns_(columns + 2)
+	Dish::Dish(const uint8_t rows, const uint8_t columns, const uint8_t aliveCellsRatio, const uint64_t seed) : rows_(rows + 2), columns_(columns + 2)
 	{
+		assert(rows_ >= 3 && columns_ >= 3);
 		dish_ = new Cell * [rows_]; // dynamic `array of pointers to cells`
 		for (auto r = 0; r < rows_; ++r)
 		{
@@ -27,21 +97,22 @@ namespace lifegame
 			}
 		}
 
-		random_device rd;     // used to initialise (seed) engine
-		mt19937 rng(rd());    // random-number engine used (Mersenne-Twister here)
-		uniform_int_distribution<int> rDistrib(0, rows_ - 1);
-		uniform_int_distribution<int> cDistrib(0, columns_ - 1);
-
-		int aliveCells = rows_ * columns_ * aliveCellsRatio / 100;
-		while (aliveCells > 0)
+		Random random(seed);
+		uint16_t probability = static_cast<uint16_t>((min(static_cast<int>(aliveCellsRatio), 100) * 256 + 50) / 100);
+		uint64_t bits = 0;
+		int remaining = 0; // the bits left to read in the current word.
+		for (auto r = 1; r < rows_ - 1; ++r)
 		{
-			int r = rDistrib(rng);
-			int c = cDistrib(rng);
-			Cell& cell = dish_[r][c];
-			if (cell.alive != 1)
+			for (auto c = 1; c < columns_ - 1; ++c)
 			{
-				cell.alive = 1;
-				--aliveCells;
+				if (remaining == 0)
+				{
+					bits = random.bernoulli(probability);
+					remaining = 64;
+				}
+				dish_[r][c].alive = static_cast<uint8_t>(bits & 1);
+				bits >>= 1;
+				--remaining;
 			}
 		}
 	}
@@ -50,6 +121,7 @@ namespace lifegame
 	{
 		rows_ = other.rows();
 		columns_ = other.columns();
+		topology_ = other.topology_;
 		dish_ = new Cell * [rows_]; // dynamic `array of pointers to cells`
 		for (auto r = 0; r < rows_; ++r)
 		{
@@ -70,6 +142,8 @@ namespace lifegame
 			return *this;
 		}
 
+		topology_ = other.topology_;
+
 		// 2. Special case : height & width remain unmodified.
 		if (rows_ == other.rows() && columns_ == other.columns())
 		{
@@ -108,7 +182,7 @@ namespace lifegame
 
 		// Assign
 		rows_ = rows;
-		columns_ = columns_;
+		columns_ = columns;
 		dish_ = dish;
 
 		return *this;
@@ -119,6 +193,7 @@ namespace lifegame
 		// Assign
 		rows_ = other.rows_;
 		columns_ = other.columns_;
+		topology_ = other.topology_;
 		dish_ = other.dish_;
 
 		// Reset
@@ -148,6 +223,7 @@ namespace lifegame
 		// Assign
 		rows_ = other.rows_;
 		columns_ = other.columns_;
+		topology_ = other.topology_;
 		dish_ = other.dish_;
 
 		// Reset
@@ -177,6 +253,30 @@ namespace lifegame
 		return columns_;
 	}
 
+	Topology Dish::topology() const
+	{
+		return topology_;
+	}
+
+	void Dish::topology(const Topology topology)
+	{
+		topology_ = topology;
+		if (topology_ == Topology::Bounded)
+		{
+			// Back to dead edges.
+			for (auto c = 0; c < columns_; ++c)
+			{
+				dish_[0][c].alive = 0;
+				dish_[rows_ - 1][c].alive = 0;
+			}
+			for (auto r = 0; r < rows_; ++r)
+			{
+				dish_[r][0].alive = 0;
+				dish_[r][columns_ - 1].alive = 0;
+			}
+		}
+	}
+
 	void Dish::cells(std::vector<uint8_t>& cells) const
 	{
 		for (auto r = 0; r < rows_; ++r)
@@ -198,86 +298,692 @@ namespace lifegame
 		return dish_[row][column];
 	}
 
-	bool Dish::cell(const uint8_t row, const uint8_t column, const uint8_t state)
+	void Dish::live(std::vector<uint8_t>& cells)
 	{
-		assert(row < rows_);
-		assert(column < columns_);
+		live(cells, Rule::Life, Engine::Cells);
+	}
 
-		// Cells outside of the living grid are immutable.
-		if (row == 0 || row == rows_ - 1 || column == 0 || column == columns_ - 1)
+	void Dish::live(std::vector<uint8_t>& cells, const Rule rule)
+	{
+		live(cells, rule, Engine::Cells);
+	}
+
+	void Dish::live(std::vector<uint8_t>& cells, const Rule rule, const Engine engine)
+	{
+		live(cells, rule, engine, 1);
+	}
+
+	void Dish::live(std::vector<uint8_t>& cells, const Rule rule, const Engine engine, const unsigned int generations)
+	{
+		assert(generations > 0);
+		if (engine == Engine::Tiles)
 		{
-			return false;
+			switch (rule)
+			{
+			case Rule::Life: liveTiles<rules::Life>(cells, generations); break;
+			case Rule::HighLife: liveTiles<rules::HighLife>(cells, generations); break;
+			case Rule::DayAndNight: liveTiles<rules::DayAndNight>(cells, generations); break;
+			case Rule::Seeds: liveTiles<rules::Seeds>(cells, generations); break;
+			}
+			return;
 		}
 
-		Cell& cell = dish_[row][column];
-		if (cell.alive != state)
+		// The other engines live generation after generation : the cells which differ are only known at the end.
+		std::vector<uint8_t> origin;
+		std::vector<uint8_t> changes;
+		if (generations > 1)
 		{
-			cell.alive = state;
-			return true;
+			pack(origin);
 		}
+		for (unsigned int generation = 0; generation < generations; ++generation)
+		{
+			auto& lived = generations > 1 ? changes : cells;
+			changes.clear();
 
-		return false;
+			// The kernels read the border as any other row & column : a torus only needs its halo refreshed.
+			if (topology_ == Topology::Torus)
+			{
+				wrap();
+			}
+			if (engine == Engine::Blocks)
+			{
+				switch (rule)
+				{
+				case Rule::Life: liveBlocks<rules::Life>(lived); break;
+				case Rule::HighLife: liveBlocks<rules::HighLife>(lived); break;
+				case Rule::DayAndNight: liveBlocks<rules::DayAndNight>(lived); break;
+				case Rule::Seeds: liveBlocks<rules::Seeds>(lived); break;
+				}
+			}
+			else
+			{
+				switch (rule)
+				{
+				case Rule::Life: liveCells<rules::Life>(lived); break;
+				case Rule::HighLife: liveCells<rules::HighLife>(lived); break;
+				case Rule::DayAndNight: liveCells<rules::DayAndNight>(lived); break;
+				case Rule::Seeds: liveCells<rules::Seeds>(lived); break;
+				}
+			}
+		}
+		if (generations > 1)
+		{
+			size_t i = 0;
+			for (auto r = 1; r < rows_ - 1; ++r)
+			{
+				for (auto c = 1; c < columns_ - 1; ++c, ++i)
+				{
+					uint8_t lived = (origin[i / 8] >> (i % 8)) & 1;
+					if (dish_[r][c].alive != lived)
+					{
+						cells.push_back(r);
+						cells.push_back(c);
+						cells.push_back(dish_[r][c].alive);
+					}
+				}
+			}
+		}
 	}
 
-	void Dish::live(std::vector<uint8_t>& cells)
+	void Dish::next(std::vector<uint8_t>& cells, const Rule rule, const uint8_t first, const uint8_t last) const
 	{
-		for (auto r = 0; r < rows_; ++r)
+		assert(first >= 1 && last <= rows_ - 1);
+		switch (rule)
+		{
+		case Rule::Life: nextRows<rules::Life>(cells, first, last); break;
+		case Rule::HighLife: nextRows<rules::HighLife>(cells, first, last); break;
+		case Rule::DayAndNight: nextRows<rules::DayAndNight>(cells, first, last); break;
+		case Rule::Seeds: nextRows<rules::Seeds>(cells, first, last); break;
+		}
+	}
+
+	template <typename Kernel>
+	void Dish::nextRows(std::vector<uint8_t>& cells, const uint8_t first, const uint8_t last) const
+	{
+		LIFEGAME_TRACE("Dish::next");
+		const bool torus = topology_ == Topology::Torus;
+		uint8_t sum[256]; // the alive cells of each column, in the rows above, at & below.
+		for (auto r = first; r < last; ++r)
 		{
+			const Cell* above = dish_[r - 1];
+			const Cell* middle = dish_[r];
+			const Cell* below = dish_[r + 1];
 			for (auto c = 0; c < columns_; ++c)
 			{
-				uint8_t lived = alive(r, c);
-				uint8_t living = live(r, c);
-				if (lived != living) {
+				sum[c] = above[c].alive + middle[c].alive + below[c].alive;
+			}
+			if (torus)
+			{
+				sum[0] = sum[columns_ - 2];
+				sum[columns_ - 1] = sum[1];
+			}
+			for (auto c = 1; c < columns_ - 1; ++c)
+			{
+				uint8_t alive = middle[c].alive;
+				uint8_t living = Kernel::next(alive, sum[c - 1] + sum[c] + sum[c + 1] - alive);
+				if (living != alive)
+				{
 					cells.push_back(r);
 					cells.push_back(c);
 					cells.push_back(living);
 				}
-				cell(r, c, living);
 			}
 		}
 	}
 
-	void Dish::modify(const std::vector<uint8_t>& cells)
+	template <typename Kernel>
+	void Dish::liveCells(std::vector<uint8_t>& cells)
 	{
-		assert(cells.size() % 3 == 0);
-		for (unsigned int i = 0; i < cells.size(); i = i + 3)
+		LIFEGAME_TRACE("Dish::live");
+		uint8_t above[256];
+		uint8_t middle[256];
+		for (auto c = 0; c < columns_; ++c)
 		{
-			cell(cells.at(i), cells.at(i + 1), cells.at(i + 2));
+			above[c] = dish_[0][c].alive;
+		}
+		for (auto r = 1; r < rows_ - 1; ++r)
+		{
+			for (auto c = 0; c < columns_; ++c)
+			{
+				middle[c] = dish_[r][c].alive;
+			}
+			const Cell* below = dish_[r + 1];
+			for (auto c = 1; c < columns_ - 1; ++c)
+			{
+				uint8_t neighbours = above[c - 1] + above[c] + above[c + 1] + middle[c - 1] + middle[c + 1] + below[c - 1].alive + below[c].alive + below[c + 1].alive;
+				uint8_t living = Kernel::next(middle[c], neighbours);
+				if (living != middle[c])
+				{
+					dish_[r][c].alive = living;
+					cells.push_back(r);
+					cells.push_back(c);
+					cells.push_back(living);
+				}
+			}
+			std::copy(middle, middle + columns_, above);
 		}
 	}
 
-	uint8_t Dish::live(const uint8_t row, const uint8_t column)
+	/**
+	* The next states of the inner 2 x 2 cells of every 4 x 4 block, by a rule : built on first use.
+	*
+	* A block is indexed by its cells : the cell at row 'y' & column 'x' (both in [0, 4[) is the bit '4 * y + x'.
+	* Its next states are the bits 0 (row 1, column 1), 1 (row 1, column 2), 2 (row 2, column 1) & 3 (row 2, column 2).
+	**/
+	template <typename Kernel>
+	static const std::vector<uint8_t>& blocks()
 	{
-		assert(row < rows_);
-		assert(column < columns_);
+		static const std::vector<uint8_t> table = [] {
+			std::vector<uint8_t> table(1 << 16);
+			for (uint32_t block = 0; block < table.size(); ++block)
+			{
+				uint8_t next = 0;
+				for (int y = 1; y <= 2; ++y)
+				{
+					for (int x = 1; x <= 2; ++x)
+					{
+						uint8_t neighbours = 0;
+						for (int dy = -1; dy <= 1; ++dy)
+						{
+							for (int dx = -1; dx <= 1; ++dx)
+							{
+								neighbours += (dy != 0 || dx != 0) ? (block >> (4 * (y + dy) + x + dx)) & 1 : 0;
+							}
+						}
+						next |= Kernel::next((block >> (4 * y + x)) & 1, neighbours) << (2 * (y - 1) + x - 1);
+					}
+				}
+				table[block] = next;
+			}
+			return table;
+		}();
+		return table;
+	}
+
+	/**
+	* Let the dish live by a rule, 2 rows at a time.
+	*
+	* The previous states of the 4 rows around the 2 living ones are kept aside as column pairs (2 bits), so that every cell lives from the same generation.
+	* Laid out 4 bits apart, the pairs of the 4 rows make a 4 x 2 column (16 bits) : 2 adjacent columns make a block index.
+	* Cells beyond the dish are dead, & the immutable border is never written.
+	**/
+	template <typename Kernel>
+	void Dish::liveBlocks(std::vector<uint8_t>& cells)
+	{
+		LIFEGAME_TRACE("Dish::live");
+		auto const& table = blocks<Kernel>();
+		const int pairs = (columns_ + 1) / 2;
+		const int count = (columns_ - 1) / 2; // the blocks in a row, from the column 1.
+		uint8_t buffers[4][128];
+		uint8_t* window[4] = { buffers[0], buffers[1], buffers[2], buffers[3] };
+		uint8_t states[128]; // the next states of the blocks.
+		uint8_t changes[128]; // the states which changed.
+
+		// Column pair 'k' holds the columns '2k' (bit 0) & '2k + 1' (bit 1).
+		auto load = [this, pairs](const int row, uint8_t* codes) {
+			if (row >= rows_)
+			{
+				std::fill(codes, codes + pairs, 0);
+				return;
+			}
+			const Cell* cells = dish_[row];
+			for (int k = 0; k < columns_ / 2; ++k)
+			{
+				codes[k] = cells[2 * k].alive | (cells[2 * k + 1].alive << 1);
+			}
+			if (columns_ % 2 != 0)
+			{
+				codes[pairs - 1] = cells[columns_ - 1].alive;
+			}
+		};
+		auto column = [&window](const int k) {
+			return static_cast<uint32_t>(window[0][k] | (window[1][k] << 4) | (window[2][k] << 8) | (window[3][k] << 12));
+		};
+		auto apply = [this, &cells](const int row, const int column, const uint8_t state) {
+			dish_[row][column].alive = state;
+			cells.push_back(row);
+			cells.push_back(column);
+			cells.push_back(state);
+		};
+
+		load(0, window[0]);
+		load(1, window[1]);
+		for (auto r = 1; r < rows_ - 1; r += 2)
+		{
+			load(r + 1, window[2]);
+			load(r + 2, window[3]);
+
+			uint8_t changed = 0;
+			uint32_t left = column(0);
+			for (auto k = 0; k < count; ++k)
+			{
+				uint32_t right = column(k + 1);
+				uint32_t block = left | (right << 2);
+				uint8_t previous = ((block >> 5) & 0x3) | ((block >> 7) & 0xC);
+				states[k] = table[block];
+				changes[k] = states[k] ^ previous;
+				changed |= changes[k];
+				left = right;
+			}
+
+			// Row after row, column after column, as the cells engine.
+			if (changed != 0)
+			{
+				for (auto k = 0; k < count; ++k)
+				{
+					if (changes[k] & 0x1)
+					{
+						apply(r, 2 * k + 1, states[k] & 1);
+					}
+					if ((changes[k] & 0x2) && 2 * k + 2 < columns_ - 1)
+					{
+						apply(r, 2 * k + 2, (states[k] >> 1) & 1);
+					}
+				}
+				for (auto k = 0; r + 1 < rows_ - 1 && k < count; ++k)
+				{
+					if (changes[k] & 0x4)
+					{
+						apply(r + 1, 2 * k + 1, (states[k] >> 2) & 1);
+					}
+					if ((changes[k] & 0x8) && 2 * k + 2 < columns_ - 1)
+					{
+						apply(r + 1, 2 * k + 2, (states[k] >> 3) & 1);
+					}
+				}
+			}
+
+			std::swap(window[0], window[2]);
+			std::swap(window[1], window[3]);
+		}
+	}
+
+	/**
+	* The memory of the two generations of a band of rows : the L1 data cache of most processors.
+	**/
+	static const size_t TILE_BYTES = 32 * 1024;
+
+	/**
+	* Let a cell live by a rule, with comparisons only : unlike a table read, a row of cells can be computed by vector instructions.
+	* The comparisons with the neighbour counts out of the rule are compiled out.
+	**/
+	template <typename Kernel, size_t... Counts>
+	static inline uint8_t evolve(const uint8_t alive, const uint8_t neighbours, std::index_sequence<Counts...>)
+	{
+		uint8_t birth = (0 | ... | (((Kernel::BIRTH >> Counts) & 1) ? static_cast<uint8_t>(neighbours == Counts) : 0));
+		uint8_t survival = (0 | ... | (((Kernel::SURVIVAL >> Counts) & 1) ? static_cast<uint8_t>(neighbours == Counts) : 0));
+		return (survival & alive) | (birth & (alive ^ 1));
+	}
+
+	/**
+	* The cells of a row of a band, border included : the widest dish, rounded up so that no scalar loop is left beside the vector instructions.
+	**/
+	static const int STRIDE = 256;
+
+	/**
+	* Let a row of a band live, every column of the stride included : the columns out of the dish are never read by its interior.
+	* The rows never overlap, & the loops are of a constant length : both are vectorized without any run-time check, even at the lowest levels of optimization.
+	*
+	* @param sum the sums of the cells of every column of the three rows, with a column before & after the stride.
+	**/
+	template <typename Kernel>
+	static void evolveRow(const uint8_t* __restrict above, const uint8_t* __restrict middle, const uint8_t* __restrict below, uint8_t* __restrict sum, uint8_t* __restrict living)
+	{
+		for (int c = 0; c < STRIDE; ++c)
+		{
+			sum[c + 1] = above[c] + middle[c] + below[c];
+		}
+		for (int c = 0; c < STRIDE; ++c)
+		{
+			living[c] = evolve<Kernel>(middle[c], sum[c] + sum[c + 1] + sum[c + 2] - middle[c], std::make_index_sequence<9>());
+		}
+	}
+
+	/**
+	* Let the dish live several generations, band after band.
+	*
+	* A pass lets every band live a few generations from the previous pass : from its own rows & a halo of rows above & below, as wide as the generations.
+	* Each generation computes one row less on each side of the band, until the band only is left : the halo rows are computed several times,
+	* but each band is read once from memory per pass instead of once per generation.
+	* The generations of a pass are bounded so that the halo stays small beside the band.
+	* A dish fitting into a single band lives one generation per pass, without any halo computed twice.
+	*
+	* Beyond the edges of a torus, the rows & the columns of the opposite edges are read : rows as they are loaded, columns after each generation.
+	* Beyond the edges of a bounded dish, the immutable border is read.
+	**/
+	template <typename Kernel>
+	void Dish::liveTiles(std::vector<uint8_t>& cells, const unsigned int generations)
+	{
+		LIFEGAME_TRACE("Dish::live");
+		const int width = columns_;
+		const int interior = rows_ - 2;
+		const bool torus = topology_ == Topology::Torus;
+		const int height = (std::max)(static_cast<int>(TILE_BYTES / (2 * STRIDE)), 8); // the rows of a band & its halo.
+
+		// The dish at the first generation, then at the start & at the end of a pass : rows after rows, border included.
+		thread_local std::vector<uint8_t> origin;
+		thread_local std::vector<uint8_t> current;
+		thread_local std::vector<uint8_t> next;
+		thread_local std::vector<uint8_t> planes[2];
+		thread_local std::vector<uint8_t> sums;
+		origin.resize(rows_ * width);
+		for (auto r = 0; r < rows_; ++r)
+		{
+			for (auto c = 0; c < width; ++c)
+			{
+				origin[r * width + c] = dish_[r][c].alive;
+			}
+		}
+
+		// The interior row a dish row stands for, beyond the edges of a torus.
+		auto source = [torus, interior](const int row) {
+			return torus ? 1 + ((row - 1) % interior + interior) % interior : row;
+		};
+		auto wrap = [torus, width](uint8_t* row) {
+			row[0] = torus ? row[width - 2] : 0;
+			row[width - 1] = torus ? row[1] : 0;
+		};
+
+		const bool single = rows_ <= height;
+		const int depth = single ? 1 : (std::max)(1, height / 8); // the generations of a pass.
+		const int band = single ? interior : height - 2 * depth;
+		current = origin;
+		next = origin;
+		planes[0].resize((single ? rows_ : height) * STRIDE);
+		planes[1].resize(planes[0].size());
+		sums.assign(STRIDE + 2, 0);
+		for (unsigned int lived = 0; lived < generations;)
+		{
+			const int steps = static_cast<int>((std::min)(static_cast<unsigned int>(depth), generations - lived));
+			for (int a = 1; a < rows_ - 1; a += band)
+			{
+				const int b = (std::min)(a + band, rows_ - 1);
+
+				// The band & its halo, in both planes : the rows out of the halo, & the border rows, are never written.
+				const int low = torus ? a - steps : (std::max)(a - steps, 0);
+				const int high = torus ? b + steps : (std::min)(b + steps, static_cast<int>(rows_));
+				for (int row = low; row < high; ++row)
+				{
+					auto from = current.data() + source(row) * width;
+					std::copy(from, from + width, planes[0].data() + (row - low) * STRIDE);
+					wrap(planes[0].data() + (row - low) * STRIDE);
+				}
+				std::copy(planes[0].begin(), planes[0].begin() + (high - low) * STRIDE, planes[1].begin());
+
+				uint8_t* from = planes[0].data();
+				uint8_t* to = planes[1].data();
+				for (int step = 1; step <= steps; ++step)
+				{
+					const int first = torus ? a - steps + step : (std::max)(a - steps + step, 1);
+					const int last = torus ? b + steps - step : (std::min)(b + steps - step, rows_ - 1);
+					for (int row = first; row < last; ++row)
+					{
+						const uint8_t* above = from + (row - low - 1) * STRIDE;
+						uint8_t* living = to + (row - low) * STRIDE;
+						evolveRow<Kernel>(above, above + STRIDE, above + 2 * STRIDE, sums.data(), living);
+						wrap(living);
+					}
+					std::swap(from, to);
+				}
+
+				for (int row = a; row < b; ++row)
+				{
+					std::copy(from + (row - low) * STRIDE + 1, from + (row - low) * STRIDE + width - 1, next.data() + row * width + 1);
+				}
+			}
+			std::swap(current, next);
+			lived += steps;
+		}
+
+		for (auto r = 1; r < rows_ - 1; ++r)
+		{
+			for (auto c = 1; c < width - 1; ++c)
+			{
+				uint8_t living = current[r * width + c];
+				if (living != origin[r * width + c])
+				{
+					dish_[r][c].alive = living;
+					cells.push_back(r);
+					cells.push_back(c);
+					cells.push_back(living);
+				}
+			}
+		}
+	}
+
+	void Dish::wrap()
+	{
+		std::copy(dish_[rows_ - 2], dish_[rows_ - 2] + columns_, dish_[0]);
+		std::copy(dish_[1], dish_[1] + columns_, dish_[rows_ - 1]);
+		for (auto r = 0; r < rows_; ++r)
+		{
+			dish_[r][0] = dish_[r][columns_ - 2];
+			dish_[r][columns_ - 1] = dish_[r][1];
+		}
+	}
+
+	bool Dish::modify(const std::vector<uint8_t>& cells, const size_t offset)
+	{
+		if (offset > cells.size() || (cells.size() - offset) % 3 != 0)
+		{
+			return false;
+		}
+
+		// Cells outside of the living grid are immutable, & states are either dead or alive : a single check of every cell, then the cells are written as they are.
+		const uint8_t* data = cells.data() + offset;
+		const size_t size = cells.size() - offset;
+		uint8_t invalid = 0;
+		for (size_t i = 0; i < size; i += 3)
+		{
+			invalid |= static_cast<uint8_t>(static_cast<uint8_t>(data[i] - 1) >= rows_ - 2) | static_cast<uint8_t>(static_cast<uint8_t>(data[i + 1] - 1) >= columns_ - 2)
+				| static_cast<uint8_t>(data[i + 2] > 1);
+		}
+		if (invalid)
+		{
+			return false;
+		}
+		for (size_t i = 0; i < size; i += 3)
+		{
+			dish_[data[i]][data[i + 1]].alive = data[i + 2];
+		}
+		return true;
+	}
+
+	/**
+	* The flips of 8 cells from their bits : a byte per cell, the first cell in the lowest byte (in memory order).
+	**/
+	static const struct Flips
+	{
+		uint64_t words[256];
 
-		// Cells outside of the living grid are immutable.
-		if (row == 0 || row == rows_ - 1 || column == 0 || column == columns_ - 1)
+		Flips()
 		{
-			return Dish::alive(row, column);
+			for (unsigned int bits = 0; bits < 256; ++bits)
+			{
+				uint8_t bytes[8];
+				for (unsigned int bit = 0; bit < 8; ++bit)
+				{
+					bytes[bit] = (bits >> bit) & 1;
+				}
+				memcpy(&words[bits], bytes, sizeof(bytes));
+			}
 		}
 
-		Cell topleftCell = Dish::cell(row - 1, column - 1);
-		Cell topCell = Dish::cell(row - 1, column);
-		Cell toprightCell = Dish::cell(row - 1, column + 1);
+		uint64_t operator[](const unsigned int bits) const
+		{
+			return words[bits];
+		}
+	} FLIPS;
 
-		Cell leftCell = Dish::cell(row, column - 1);
-		Cell rightCell = Dish::cell(row, column + 1);
+	bool Dish::modifyBits(const std::vector<uint8_t>& bits, const size_t offset)
+	{
+		const size_t width = columns_ - 2;
+		const size_t count = (rows_ - 2) * width;
+		if (offset > bits.size() || bits.size() - offset != (count + 7) / 8 || (count % 8 != 0 && bits.back() >> (count % 8) != 0))
+		{
+			return false;
+		}
+
+		// Row after row, the bits of 8 cells are read at once : empty ones are skipped, the others flip their cells as a single word.
+		const uint8_t* data = bits.data() + offset;
+		const size_t size = bits.size() - offset;
+		size_t i = 0;
+		for (auto r = 1; r < rows_ - 1; ++r)
+		{
+			Cell* cells = dish_[r] + 1;
+			size_t c = 0;
+			for (; c + 8 <= width; c += 8, i += 8)
+			{
+				unsigned int pair = data[i >> 3] | ((i >> 3) + 1 < size ? data[(i >> 3) + 1] << 8 : 0);
+				unsigned int byte = (pair >> (i & 7)) & 0xFF;
+				if (byte != 0)
+				{
+					uint64_t states;
+					memcpy(&states, cells + c, sizeof(states));
+					states ^= FLIPS[byte];
+					memcpy(cells + c, &states, sizeof(states));
+				}
+			}
+			for (; c < width; ++c, ++i)
+			{
+				cells[c].alive ^= static_cast<uint8_t>((data[i >> 3] >> (i & 7)) & 1);
+			}
+		}
+		return true;
+	}
 
-		Cell botleftCell = Dish::cell(row + 1, column - 1);
-		Cell botCell = Dish::cell(row + 1, column);
-		Cell botrightCell = Dish::cell(row + 1, column + 1);
+	/**
+	* Read a run, a variable length integer of at most 3 bytes : enough for the 253 x 253 living cells.
+	*
+	* @param runs the runs.
+	* @param i the position of the run, moved after it.
+	* @param run the run.
+	* @return whether (or not) the run is whole.
+	*/
+	static bool readRun(const std::vector<uint8_t>& runs, size_t& i, size_t& run)
+	{
+		run = 0;
+		for (unsigned int shift = 0; shift < 21 && i < runs.size(); shift += 7)
+		{
+			uint8_t byte = runs[i++];
+			run |= static_cast<size_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
 
-		uint8_t aliveCells = topleftCell.alive + topCell.alive + toprightCell.alive + leftCell.alive + rightCell.alive + botleftCell.alive + botCell.alive + botrightCell.alive;
+	bool Dish::modifyRuns(const std::vector<uint8_t>& runs, const size_t offset)
+	{
+		const size_t width = columns_ - 2;
+		const size_t count = (rows_ - 2) * width;
+		if (offset > runs.size())
+		{
+			return false;
+		}
 
-		Cell cell = Dish::cell(row, column);
-		if (aliveCells == 3 || (cell.alive == 1 && aliveCells == 2))
+		// The runs are decoded twice : validated first, then applied.
+		size_t cell = 0;
+		size_t run;
+		for (size_t i = offset; i < runs.size(); ++cell)
 		{
-			return 1; // 1 stands for "alive cell".
+			if (!readRun(runs, i, run) || (cell += run) >= count)
+			{
+				return false;
+			}
 		}
-		else
+		size_t row = 1;
+		size_t column = 0; // the column of the next cell, from 0.
+		for (size_t i = offset; i < runs.size(); ++column)
+		{
+			readRun(runs, i, run);
+			column += run;
+			if (column >= width)
+			{
+				row += column / width;
+				column %= width;
+			}
+			dish_[row][column + 1].alive ^= 1;
+		}
+		return true;
+	}
+
+	void Dish::pack(std::vector<uint8_t>& bits) const
+	{
+		// Each byte is gathered from its 8 cells, then written once : whole bytes at once within a row, cell after cell across rows.
+		size_t offset = bits.size();
+		bits.resize(offset + ((rows_ - 2) * (columns_ - 2) + 7) / 8, 0);
+		uint8_t* data = bits.data() + offset;
+		unsigned int byte = 0;
+		unsigned int bit = 0;
+		for (auto r = 1; r < rows_ - 1; ++r)
+		{
+			const Cell* cells = dish_[r];
+			auto c = 1;
+			for (; c < columns_ - 1 && bit != 0; ++c)
+			{
+				byte |= static_cast<unsigned int>(cells[c].alive != 0) << bit;
+				if (++bit == 8)
+				{
+					*data++ = static_cast<uint8_t>(byte);
+					byte = 0;
+					bit = 0;
+				}
+			}
+			for (; c + 8 <= columns_ - 1; c += 8)
+			{
+				const Cell* eight = cells + c;
+				*data++ = static_cast<uint8_t>((eight[0].alive != 0) | (eight[1].alive != 0) << 1 | (eight[2].alive != 0) << 2 | (eight[3].alive != 0) << 3
+					| (eight[4].alive != 0) << 4 | (eight[5].alive != 0) << 5 | (eight[6].alive != 0) << 6 | (eight[7].alive != 0) << 7);
+			}
+			for (; c < columns_ - 1; ++c)
+			{
+				byte |= static_cast<unsigned int>(cells[c].alive != 0) << bit;
+				++bit;
+			}
+		}
+		if (bit != 0)
+		{
+			*data = static_cast<uint8_t>(byte);
+		}
+	}
+
+	void Dish::unpack(const std::vector<uint8_t>& bits)
+	{
+		assert(bits.size() == static_cast<size_t>(((rows_ - 2) * (columns_ - 2) + 7) / 8));
+		size_t i = 0;
+		for (auto r = 1; r < rows_ - 1; ++r)
+		{
+			for (auto c = 1; c < columns_ - 1; ++c, ++i)
+			{
+				dish_[r][c].alive = (bits[i / 8] >> (i % 8)) & 1;
+			}
+		}
+	}
+
+	void Dish::pack(const uint8_t row, std::vector<uint8_t>& bits) const
+	{
+		assert(row < rows_);
+		size_t offset = bits.size();
+		bits.resize(offset + (columns_ - 2 + 7) / 8, 0);
+		for (auto c = 1; c < columns_ - 1; ++c)
+		{
+			if (dish_[row][c].alive)
+			{
+				bits[offset + (c - 1) / 8] |= static_cast<uint8_t>(1 << ((c - 1) % 8));
+			}
+		}
+	}
+
+	void Dish::unpack(const uint8_t row, const std::vector<uint8_t>& bits, const size_t offset)
+	{
+		assert(row < rows_);
+		assert(bits.size() >= offset + (columns_ - 2 + 7) / 8);
+		for (auto c = 1; c < columns_ - 1; ++c)
 		{
-			return 0; // 0 stands for "dead cell".
+			dish_[row][c].alive = (bits[offset + (c - 1) / 8] >> ((c - 1) % 8)) & 1;
 		}
 	}
 
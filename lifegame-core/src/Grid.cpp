@@ -1,57 +1,240 @@
 #include <Grid.hpp>
-#include <cstdint>
+#include <algorithm>
+#include <assert.h>
+#include <cstring>
+#include <limits>
 
-// TODO Display dish as a grid
 namespace lifegame
 {
 
-	Grid::Grid(const Dish& dish, const uint8_t cellDimension) : dish_(dish)
+	/**
+	* The characters of 2 cells, one above the other, by their states : the upper cell in the lowest bit (UTF-8 half blocks).
+	**/
+	static const char* const CHARACTERS[] = { " ", "\xE2\x96\x80", "\xE2\x96\x84", "\xE2\x96\x88" };
+
+	/**
+	* The longest gap of unchanged characters written again rather than skipped by a cursor move : no longer than the move.
+	**/
+	static const unsigned int GAP = 2;
+
+	/**
+	* The colors of the alive & dead cells in the framebuffer, as red, green & blue bytes.
+	**/
+	static const uint8_t ALIVE[] = { 0, 255, 0 };
+	static const uint8_t DEAD[] = { 255, 0, 0 };
+
+	/**
+	* Retrieve the states of the 2 cells of a character, from packed states.
+	*
+	* @param states the packed states.
+	* @param rows the rows of the dish, its border excluded.
+	* @param columns the columns of the dish, its border excluded.
+	* @param line the line of the character.
+	* @param column the column of the character.
+	* @return the states : the upper cell in the lowest bit.
+	**/
+	static unsigned int pair(const std::vector<uint8_t>& states, const size_t rows, const size_t columns, const size_t line, const size_t column)
 	{
-		uint8_t rows = dish_.rows();
-		uint8_t columns = dish_.columns();
+		size_t upper = 2 * line * columns + column;
+		size_t lower = upper + columns;
+		unsigned int pair = (states[upper / 8] >> (upper % 8)) & 1;
+		if (2 * line + 1 < rows)
+		{
+			pair |= ((states[lower / 8] >> (lower % 8)) & 1) << 1;
+		}
+		return pair;
+	}
 
-		/*
-		// Create a vertex array of quads.
-		vertices_.setPrimitiveType(sf::Quads);
-		vertices_.resize(rows * columns * 4);
+	Grid::Grid(std::ostream& terminal, const unsigned int fps) :
+		terminal_(&terminal),
+		period_(fps > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / fps : Clock::duration::zero())
+	{
+	}
 
-		uint8_t width = cellDimension;
-		uint8_t height = cellDimension;
+	Grid::Grid(const uint8_t cellDimension) : cellDimension_(cellDimension > 0 ? cellDimension : 1)
+	{
+	}
+
+	Grid::~Grid()
+	{
+		if (started_)
+		{
+			// Back to the main screen, with a visible cursor.
+			*terminal_ << "\x1b[?25h\x1b[?1049l" << std::flush;
+		}
+	}
+
+	bool Grid::draw(const Dish& dish, const uint32_t generation, const Clock::time_point now)
+	{
+		assert(terminal_ != nullptr);
+		if (started_ && now < due_)
+		{
+			return false;
+		}
+		due_ = now + period_;
 
-		for (auto r = 0; r < rows; ++r)
+		frame_.clear();
+		if (!started_)
 		{
-			for (auto c = 0; c < columns; ++c)
+			// The alternate screen, without cursor.
+			frame_ += "\x1b[?1049h\x1b[?25l";
+			started_ = true;
+		}
+		states_.clear();
+		dish.pack(states_);
+		if (dish.rows() - 2 != rows_ || dish.columns() - 2 != columns_)
+		{
+			rows_ = dish.rows() - 2;
+			columns_ = dish.columns() - 2;
+			invalid_ = true;
+		}
+		if (invalid_)
+		{
+			// A cleared screen draws dead cells.
+			frame_ += "\x1b[2J";
+			drawn_.assign(states_.size(), 0);
+			invalid_ = false;
+		}
+
+		// The cells of a line are contiguous in the packed states : lines whose bytes are unchanged are skipped at once.
+		const unsigned int lines = (rows_ + 1) / 2;
+		unsigned int cursorLine = (std::numeric_limits<unsigned int>::max)();
+		unsigned int cursorColumn = 0;
+		for (unsigned int l = 0; l < lines; ++l)
+		{
+			size_t first = 2 * l * columns_ / 8;
+			size_t last = (std::min)(static_cast<size_t>(((2 * l + 2) * columns_ + 7) / 8), states_.size());
+			if (std::memcmp(states_.data() + first, drawn_.data() + first, last - first) == 0)
+			{
+				continue;
+			}
+			// A character changes when either of its cells does : the bits of the cells differ from the drawn ones.
+			size_t upper = 2 * l * columns_;
+			size_t lower = 2 * l + 1 < rows_ ? upper + columns_ : upper;
+			for (unsigned int c = 0; c < columns_; ++c, ++upper, ++lower)
 			{
-				// Get a quad from the vertex array for given coordinates.
-				sf::Vertex* quad = &vertices_[(r + c * rows) * 4];
-
-				// Define quad positions.
-				quad[0].position = sf::Vector2f(r * width, c * height);
-				quad[1].position = sf::Vector2f((r + 1) * width, c * height);
-				quad[2].position = sf::Vector2f((r + 1) * width, (c + 1) * height);
-				quad[3].position = sf::Vector2f(r * width, (c + 1) * height);
-
-				// Define quad colours.
-				sf::Color color = sf::Color::Red;
-				if (dish_.alive(r, c))
+				if ((((states_[upper / 8] ^ drawn_[upper / 8]) >> (upper % 8)) & 1) == 0 && (((states_[lower / 8] ^ drawn_[lower / 8]) >> (lower % 8)) & 1) == 0)
 				{
-					color = std::move(sf::Color::Green);
+					continue;
 				}
-				quad[0].color = color;
-				quad[1].color = color;
-				quad[2].color = color;
-				quad[3].color = color;
+				if (cursorLine == l && c >= cursorColumn && c - cursorColumn <= GAP)
+				{
+					// Writing the few unchanged characters in between is shorter than moving the cursor.
+					for (; cursorColumn < c; ++cursorColumn)
+					{
+						character(l, cursorColumn);
+					}
+				}
+				else
+				{
+					move(l, c);
+				}
+				character(l, c);
+				cursorLine = l;
+				cursorColumn = c + 1;
 			}
 		}
-		*/
+
+		move(lines, 0);
+		frame_ += "generation ";
+		frame_ += std::to_string(generation);
+		frame_ += "\x1b[K";
+
+		// A single write for the whole frame.
+		terminal_->write(frame_.data(), static_cast<std::streamsize>(frame_.size()));
+		terminal_->flush();
+		std::swap(drawn_, states_);
+		return true;
+	}
+
+	void Grid::invalidate()
+	{
+		invalid_ = true;
 	}
 
-	/*
-	void Grid::draw(sf::RenderTarget& target, sf::RenderStates states) const
+	void Grid::rasterise(const Dish& dish)
 	{
-		states.transform *= getTransform();
-		target.draw(vertices_, states);
+		states_.clear();
+		dish.pack(states_);
+		const size_t rows = dish.rows() - 2;
+		const size_t columns = dish.columns() - 2;
+		if (rows != height_ / cellDimension_ || columns != width_ / cellDimension_)
+		{
+			// A dead framebuffer, for dead cells.
+			width_ = static_cast<unsigned int>(columns * cellDimension_);
+			height_ = static_cast<unsigned int>(rows * cellDimension_);
+			framebuffer_.resize(static_cast<size_t>(width_) * height_ * 3);
+			for (size_t p = 0; p < framebuffer_.size(); p += 3)
+			{
+				std::copy(DEAD, DEAD + 3, framebuffer_.begin() + p);
+			}
+			rasterised_.assign(states_.size(), 0);
+		}
+
+		// Unchanged bytes of states are skipped at once : only the changed cells are painted.
+		for (size_t b = 0; b < states_.size(); ++b)
+		{
+			unsigned int changed = states_[b] ^ rasterised_[b];
+			for (unsigned int bit = 0; changed != 0; ++bit, changed >>= 1)
+			{
+				if (changed & 1)
+				{
+					size_t i = b * 8 + bit;
+					paint(i / columns, i % columns, (states_[b] >> bit) & 1);
+				}
+			}
+		}
+		std::swap(rasterised_, states_);
+	}
+
+	const std::vector<uint8_t>& Grid::framebuffer() const
+	{
+		return framebuffer_;
+	}
+
+	unsigned int Grid::width() const
+	{
+		return width_;
+	}
+
+	unsigned int Grid::height() const
+	{
+		return height_;
+	}
+
+	void Grid::write(std::ostream& output) const
+	{
+		output << "P6\n" << width_ << " " << height_ << "\n255\n";
+		output.write(reinterpret_cast<const char*>(framebuffer_.data()), static_cast<std::streamsize>(framebuffer_.size()));
+	}
+
+	void Grid::character(const unsigned int line, const unsigned int column)
+	{
+		frame_ += CHARACTERS[pair(states_, rows_, columns_, line, column)];
+	}
+
+	void Grid::move(const unsigned int line, const unsigned int column)
+	{
+		frame_ += "\x1b[";
+		frame_ += std::to_string(line + 1);
+		frame_ += ';';
+		frame_ += std::to_string(column + 1);
+		frame_ += 'H';
+	}
+
+	void Grid::paint(const size_t row, const size_t column, const bool alive)
+	{
+		const uint8_t* color = alive ? ALIVE : DEAD;
+		for (size_t y = 0; y < cellDimension_; ++y)
+		{
+			uint8_t* pixel = framebuffer_.data() + ((row * cellDimension_ + y) * width_ + column * cellDimension_) * 3;
+			for (size_t x = 0; x < cellDimension_; ++x, pixel += 3)
+			{
+				pixel[0] = color[0];
+				pixel[1] = color[1];
+				pixel[2] = color[2];
+			}
+		}
 	}
-	*/
 
 }
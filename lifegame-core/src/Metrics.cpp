@@ -0,0 +1,250 @@
+#include <Metrics.hpp>
+#include <algorithm>
+#include <assert.h>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace lifegame
+{
+	namespace metrics
+	{
+		/**
+		* The metrics of a thread : written by the thread only, read by the collecting thread.
+		**/
+		struct Block
+		{
+			std::atomic<int64_t> counters[COUNTERS];
+			std::atomic<uint64_t> sums[HISTOGRAMS];
+			std::atomic<uint64_t> buckets[HISTOGRAMS][BUCKETS];
+
+			Block()
+			{
+				for (auto& counter : counters)
+				{
+					counter.store(0, std::memory_order_relaxed);
+				}
+				for (size_t h = 0; h < HISTOGRAMS; ++h)
+				{
+					sums[h].store(0, std::memory_order_relaxed);
+					for (auto& bucket : buckets[h])
+					{
+						bucket.store(0, std::memory_order_relaxed);
+					}
+				}
+			}
+
+			void merge(const Block& other)
+			{
+				for (size_t c = 0; c < COUNTERS; ++c)
+				{
+					counters[c].fetch_add(other.counters[c].load(std::memory_order_relaxed), std::memory_order_relaxed);
+				}
+				for (size_t h = 0; h < HISTOGRAMS; ++h)
+				{
+					sums[h].fetch_add(other.sums[h].load(std::memory_order_relaxed), std::memory_order_relaxed);
+					for (size_t b = 0; b < BUCKETS; ++b)
+					{
+						buckets[h][b].fetch_add(other.buckets[h][b].load(std::memory_order_relaxed), std::memory_order_relaxed);
+					}
+				}
+			}
+		};
+
+		/**
+		* The names of the metrics & the blocks of the threads.
+		**/
+		class Registry
+		{
+
+		public:
+			size_t counter(const char* name)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				return index(counters_, name, COUNTERS);
+			}
+
+			size_t histogram(const char* name)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				return index(histograms_, name, HISTOGRAMS);
+			}
+
+			Block* attach()
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				blocks_.push_back(new Block());
+				return blocks_.back();
+			}
+
+			void detach(Block* block)
+			{
+				// The metrics of an ended thread are kept.
+				std::lock_guard<std::mutex> lock(mutex_);
+				retired_.merge(*block);
+				blocks_.erase(std::find(blocks_.begin(), blocks_.end(), block));
+				delete block;
+			}
+
+			void collect(std::vector<CounterValue>& counters, std::vector<HistogramValue>& histograms)
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				Block total;
+				total.merge(retired_);
+				for (auto block : blocks_)
+				{
+					total.merge(*block);
+				}
+
+				for (size_t c = 0; c < counters_.size(); ++c)
+				{
+					CounterValue counter;
+					counter.name = counters_[c];
+					counter.value = total.counters[c].load(std::memory_order_relaxed);
+					counters.push_back(counter);
+				}
+				for (size_t h = 0; h < histograms_.size(); ++h)
+				{
+					HistogramValue histogram;
+					histogram.name = histograms_[h];
+					histogram.sum = total.sums[h].load(std::memory_order_relaxed);
+					for (size_t b = 0; b < BUCKETS; ++b)
+					{
+						histogram.buckets[b] = total.buckets[h][b].load(std::memory_order_relaxed);
+						histogram.count += histogram.buckets[b];
+					}
+					histograms.push_back(histogram);
+				}
+			}
+
+		private:
+			static size_t index(std::vector<std::string>& names, const char* name, const size_t capacity)
+			{
+				// A name registered twice shares its metric.
+				auto found = std::find(names.cbegin(), names.cend(), name);
+				if (found != names.cend())
+				{
+					return found - names.cbegin();
+				}
+				assert(names.size() < capacity);
+				if (names.size() == capacity)
+				{
+					return capacity - 1;
+				}
+				names.push_back(name);
+				return names.size() - 1;
+			}
+
+			std::mutex mutex_;
+			std::vector<std::string> counters_;
+			std::vector<std::string> histograms_;
+			std::vector<Block*> blocks_;
+			Block retired_;
+
+		};
+
+		static Registry& registry()
+		{
+			// Created before, & destroyed after, any metric or thread block.
+			static Registry registry;
+			return registry;
+		}
+
+		/**
+		* The block of the calling thread, attached on its first metric.
+		**/
+		static Block& local()
+		{
+			struct Local
+			{
+				Block* block;
+				Local() : block(registry().attach())
+				{
+				}
+				~Local()
+				{
+					registry().detach(block);
+				}
+			};
+			thread_local Local local;
+			return *local.block;
+		}
+
+		static inline size_t bucket(const uint64_t value)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			return _BitScanReverse64(&index, value) ? index + 1 : 0;
+#else
+			return value == 0 ? 0 : 64 - __builtin_clzll(value);
+#endif
+		}
+
+		Counter::Counter(const char* name) : index_(registry().counter(name))
+		{
+		}
+
+		void Counter::add(const int64_t value)
+		{
+			// Only the owning thread writes its copy : no read-modify-write needed.
+			auto& counter = local().counters[index_];
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		Histogram::Histogram(const char* name) : index_(registry().histogram(name))
+		{
+		}
+
+		void Histogram::record(const uint64_t value)
+		{
+			auto& block = local();
+			auto& sum = block.sums[index_];
+			sum.store(sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			auto& count = block.buckets[index_][bucket(value)];
+			count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		uint64_t HistogramValue::quantile(const double quantile) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+			auto rank = static_cast<uint64_t>(std::ceil(quantile * count));
+			uint64_t seen = 0;
+			for (size_t b = 0; b < BUCKETS; ++b)
+			{
+				seen += buckets[b];
+				if (seen >= rank && buckets[b] > 0)
+				{
+					return b == 0 ? 0 : b == BUCKETS - 1 ? UINT64_MAX : (static_cast<uint64_t>(1) << b) - 1;
+				}
+			}
+			return UINT64_MAX;
+		}
+
+		void collect(std::vector<CounterValue>& counters, std::vector<HistogramValue>& histograms)
+		{
+			registry().collect(counters, histograms);
+		}
+
+		void write(const std::vector<CounterValue>& counters, const std::vector<HistogramValue>& histograms, std::string& text)
+		{
+			std::ostringstream stream;
+			for (auto const& counter : counters)
+			{
+				stream << counter.name << " " << counter.value << "\n";
+			}
+			for (auto const& histogram : histograms)
+			{
+				stream << histogram.name << " count=" << histogram.count << " mean=" << (histogram.count == 0 ? 0 : histogram.sum / histogram.count)
+					<< " p50=" << histogram.quantile(0.5) << " p99=" << histogram.quantile(0.99) << " p999=" << histogram.quantile(0.999) << "\n";
+			}
+			text += stream.str();
+		}
+	}
+}
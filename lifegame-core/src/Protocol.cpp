@@ -0,0 +1,188 @@
+#include <Protocol.hpp>
+#include <algorithm>
+#include <assert.h>
+
+namespace lifegame
+{
+	namespace protocol
+	{
+		void header(const Reply reply, const uint32_t generation, std::vector<uint8_t>& packet)
+		{
+			packet.push_back(static_cast<uint8_t>(reply));
+			packet.push_back(static_cast<uint8_t>(generation >> 24));
+			packet.push_back(static_cast<uint8_t>(generation >> 16));
+			packet.push_back(static_cast<uint8_t>(generation >> 8));
+			packet.push_back(static_cast<uint8_t>(generation));
+		}
+
+		bool header(const std::vector<uint8_t>& packet, Reply& reply, uint32_t& generation)
+		{
+			if (packet.size() < REPLY_HEADER_SIZE)
+			{
+				return false;
+			}
+			reply = static_cast<Reply>(packet[0]);
+			generation = (static_cast<uint32_t>(packet[1]) << 24) | (static_cast<uint32_t>(packet[2]) << 16) | (static_cast<uint32_t>(packet[3]) << 8) | static_cast<uint32_t>(packet[4]);
+			return reply == Reply::Snapshot || reply == Reply::Delta || reply == Reply::Seed || reply == Reply::Session || reply == Reply::Stats || reply == Reply::Bitmap || reply == Reply::Runs;
+		}
+
+		bool delta(const Reply reply)
+		{
+			return reply == Reply::Delta || reply == Reply::Bitmap || reply == Reply::Runs;
+		}
+
+		/**
+		* The size of a run, as a variable length integer (see 'Dish::modifyRuns').
+		*/
+		static size_t runSize(const size_t run)
+		{
+			return run < (1 << 7) ? 1 : run < (1 << 14) ? 2 : 3;
+		}
+
+		void delta(const Dish& dish, const std::vector<uint8_t>& delta, std::vector<uint8_t>& packet)
+		{
+			assert(delta.size() >= REPLY_HEADER_SIZE && (delta.size() - REPLY_HEADER_SIZE) % 3 == 0);
+			const size_t width = dish.columns() - 2;
+			const size_t count = (dish.rows() - 2) * width;
+			const size_t triples = delta.size() - REPLY_HEADER_SIZE;
+			const size_t bitmap = (count + 7) / 8;
+
+			// The cells are encoded by their position only when they are living cells, row after row : as any delta computed by a dish.
+			size_t runs = 0;
+			size_t next = 0; // the position after the previous cell.
+			bool ordered = true;
+			for (size_t i = REPLY_HEADER_SIZE; i < delta.size() && ordered; i += 3)
+			{
+				size_t row = static_cast<size_t>(delta[i]) - 1;
+				size_t column = static_cast<size_t>(delta[i + 1]) - 1;
+				size_t cell = row * width + column;
+				ordered = row < dish.rows() - 2u && column < width && cell >= next;
+				runs += runSize(cell - next);
+				next = cell + 1;
+			}
+			if (!ordered || triples <= (std::min)(runs, bitmap))
+			{
+				packet.insert(packet.end(), delta.cbegin(), delta.cend());
+				return;
+			}
+
+			// Same header, but the reply type.
+			packet.push_back(static_cast<uint8_t>(runs < bitmap ? Reply::Runs : Reply::Bitmap));
+			packet.insert(packet.end(), delta.cbegin() + 1, delta.cbegin() + REPLY_HEADER_SIZE);
+			size_t offset = packet.size();
+			if (runs < bitmap)
+			{
+				next = 0;
+				for (size_t i = REPLY_HEADER_SIZE; i < delta.size(); i += 3)
+				{
+					size_t cell = (delta[i] - 1u) * width + (delta[i + 1] - 1u);
+					size_t run = cell - next;
+					while (run >= 0x80)
+					{
+						packet.push_back(static_cast<uint8_t>(run | 0x80));
+						run >>= 7;
+					}
+					packet.push_back(static_cast<uint8_t>(run));
+					next = cell + 1;
+				}
+			}
+			else
+			{
+				packet.resize(offset + bitmap, 0);
+				for (size_t i = REPLY_HEADER_SIZE; i < delta.size(); i += 3)
+				{
+					size_t cell = (delta[i] - 1u) * width + (delta[i + 1] - 1u);
+					packet[offset + cell / 8] |= static_cast<uint8_t>(1 << (cell % 8));
+				}
+			}
+		}
+
+		bool delta(const std::vector<uint8_t>& packet, Dish& dish)
+		{
+			Reply reply;
+			uint32_t generation;
+			if (!header(packet, reply, generation))
+			{
+				return false;
+			}
+			switch (reply)
+			{
+			case Reply::Delta: return dish.modify(packet, REPLY_HEADER_SIZE);
+			case Reply::Bitmap: return dish.modifyBits(packet, REPLY_HEADER_SIZE);
+			case Reply::Runs: return dish.modifyRuns(packet, REPLY_HEADER_SIZE);
+			default: return false;
+			}
+		}
+
+		void seed(const uint8_t version, const uint64_t seed, std::vector<uint8_t>& packet)
+		{
+			packet.push_back(version);
+			for (int shift = 56; shift >= 0; shift -= 8)
+			{
+				packet.push_back(static_cast<uint8_t>(seed >> shift));
+			}
+		}
+
+		bool seed(const std::vector<uint8_t>& packet, uint8_t& version, uint64_t& seed)
+		{
+			if (packet.size() != REPLY_HEADER_SIZE + 1 + sizeof(uint64_t))
+			{
+				return false;
+			}
+			version = packet[REPLY_HEADER_SIZE];
+			seed = 0;
+			for (size_t i = REPLY_HEADER_SIZE + 1; i < packet.size(); ++i)
+			{
+				seed = (seed << 8) | packet[i];
+			}
+			return true;
+		}
+
+		void token(const uint64_t token, std::vector<uint8_t>& packet)
+		{
+			for (int shift = 56; shift >= 0; shift -= 8)
+			{
+				packet.push_back(static_cast<uint8_t>(token >> shift));
+			}
+		}
+
+		bool token(const std::vector<uint8_t>& packet, const size_t offset, uint64_t& token)
+		{
+			if (packet.size() != offset + sizeof(uint64_t))
+			{
+				return false;
+			}
+			token = 0;
+			for (size_t i = offset; i < packet.size(); ++i)
+			{
+				token = (token << 8) | packet[i];
+			}
+			return true;
+		}
+
+		void snapshot(const Dish& dish, std::vector<uint8_t>& packet)
+		{
+			packet.push_back(dish.rows() - 2);
+			packet.push_back(dish.columns() - 2);
+			dish.pack(packet);
+		}
+
+		std::unique_ptr<Dish> snapshot(const std::vector<uint8_t>& packet)
+		{
+			if (packet.size() < REPLY_HEADER_SIZE + 2)
+			{
+				return nullptr;
+			}
+			uint8_t rows = packet[REPLY_HEADER_SIZE];
+			uint8_t columns = packet[REPLY_HEADER_SIZE + 1];
+			std::vector<uint8_t> bits(packet.cbegin() + REPLY_HEADER_SIZE + 2, packet.cend());
+			if (rows == 0 || rows > DIMENSION || columns == 0 || columns > DIMENSION || bits.size() != static_cast<size_t>((rows * columns + 7) / 8))
+			{
+				return nullptr;
+			}
+			auto dish = std::make_unique<Dish>(rows, columns, 0, 0);
+			dish->unpack(bits);
+			return dish;
+		}
+	}
+}
@@ -0,0 +1,74 @@
+#include <Random.hpp>
+#include <assert.h>
+
+namespace lifegame
+{
+
+	static inline uint64_t rotate(const uint64_t bits, const int shift)
+	{
+		return (bits << shift) | (bits >> (64 - shift));
+	}
+
+	/**
+	* Create a new generator.
+	*
+	* The seed is expanded with SplitMix64, so that close seeds give unrelated states.
+	**/
+	Random::Random(const uint64_t seed)
+	{
+		uint64_t splitmix = seed;
+		for (auto& state : state_)
+		{
+			uint64_t z = (splitmix += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			state = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t Random::next()
+	{
+		const uint64_t result = rotate(state_[1] * 5, 7) * 9;
+		const uint64_t t = state_[1] << 17;
+		state_[2] ^= state_[0];
+		state_[3] ^= state_[1];
+		state_[1] ^= state_[2];
+		state_[0] ^= state_[3];
+		state_[2] ^= t;
+		state_[3] = rotate(state_[3], 45);
+		return result;
+	}
+
+	/**
+	* Draw 64 random bits, each one set with a given probability.
+	*
+	* The probability bits are read from the lowest to the highest : a set bit ORs a new random word, a clear bit ANDs it.
+	* Each step halves the probability & adds the read bit value, giving exactly 'probability' / 256 after 8 steps.
+	**/
+	uint64_t Random::bernoulli(const uint16_t probability)
+	{
+		assert(probability <= 256);
+		if (probability == 0)
+		{
+			return 0;
+		}
+		if (probability >= 256)
+		{
+			return ~0ull;
+		}
+
+		// Clear bits before the lowest set one would AND a zero word : they are skipped.
+		int bit = 0;
+		while ((probability & (1 << bit)) == 0)
+		{
+			++bit;
+		}
+		uint64_t bits = next();
+		for (++bit; bit < 8; ++bit)
+		{
+			bits = (probability & (1 << bit)) ? (bits | next()) : (bits & next());
+		}
+		return bits;
+	}
+
+}
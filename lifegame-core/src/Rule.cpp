@@ -0,0 +1,43 @@
+#include <Rule.hpp>
+
+namespace lifegame
+{
+
+	uint32_t code(const Rule rule)
+	{
+		switch (rule)
+		{
+		case Rule::Life: return rules::Life::CODE;
+		case Rule::HighLife: return rules::HighLife::CODE;
+		case Rule::DayAndNight: return rules::DayAndNight::CODE;
+		case Rule::Seeds: return rules::Seeds::CODE;
+		}
+		return 0;
+	}
+
+	const char* name(const Rule rule)
+	{
+		switch (rule)
+		{
+		case Rule::Life: return "life";
+		case Rule::HighLife: return "highlife";
+		case Rule::DayAndNight: return "daynight";
+		case Rule::Seeds: return "seeds";
+		}
+		return "?";
+	}
+
+	bool rule(const std::string& name, Rule& rule)
+	{
+		for (uint8_t r = 0; r < RULES; ++r)
+		{
+			if (name == lifegame::name(static_cast<Rule>(r)))
+			{
+				rule = static_cast<Rule>(r);
+				return true;
+			}
+		}
+		return false;
+	}
+
+}
@@ -0,0 +1,125 @@
+#include <Trace.hpp>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lifegame
+{
+	namespace trace
+	{
+		/**
+		* The latest spans of a thread : written by the thread only, read by the dumping thread.
+		**/
+		struct Ring
+		{
+			struct Event
+			{
+				std::atomic<const char*> name{ nullptr };
+				std::atomic<int64_t> start{ 0 }; // in nanoseconds.
+				std::atomic<int64_t> duration{ 0 }; // in nanoseconds.
+			};
+
+			explicit Ring(const size_t thread) : thread(thread), events(CAPACITY)
+			{
+			}
+
+			size_t thread;
+			std::vector<Event> events;
+			std::atomic<uint64_t> written{ 0 };
+		};
+
+		/**
+		* The rings of every thread, kept once the thread ended.
+		**/
+		class Registry
+		{
+
+		public:
+			std::shared_ptr<Ring> attach()
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				rings_.push_back(std::make_shared<Ring>(rings_.size() + 1));
+				return rings_.back();
+			}
+
+			std::vector<std::shared_ptr<Ring>> rings()
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				return rings_;
+			}
+
+		private:
+			std::mutex mutex_;
+			std::vector<std::shared_ptr<Ring>> rings_;
+
+		};
+
+		static Registry& registry()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		static Ring& local()
+		{
+			thread_local std::shared_ptr<Ring> ring = registry().attach();
+			return *ring;
+		}
+
+		static int64_t nanoseconds(const std::chrono::steady_clock::time_point time)
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+		}
+
+		Span::Span(const char* name) : name_(name), start_(std::chrono::steady_clock::now())
+		{
+		}
+
+		Span::~Span()
+		{
+			record(name_, start_, std::chrono::steady_clock::now());
+		}
+
+		void record(const char* name, const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+		{
+			auto& ring = local();
+			auto written = ring.written.load(std::memory_order_relaxed);
+			auto& event = ring.events[written % CAPACITY];
+			event.name.store(name, std::memory_order_relaxed);
+			event.start.store(nanoseconds(start), std::memory_order_relaxed);
+			event.duration.store(nanoseconds(end) - nanoseconds(start), std::memory_order_relaxed);
+			ring.written.store(written + 1, std::memory_order_release);
+		}
+
+		bool dump(const std::string& path)
+		{
+			std::ofstream file(path, std::ios::trunc);
+			file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+			bool first = true;
+			for (auto const& ring : registry().rings())
+			{
+				auto written = ring->written.load(std::memory_order_acquire);
+				auto oldest = written > CAPACITY ? written - CAPACITY : 0;
+				for (auto e = oldest; e < written; ++e)
+				{
+					auto& event = ring->events[e % CAPACITY];
+					auto name = event.name.load(std::memory_order_relaxed);
+					if (name == nullptr)
+					{
+						continue;
+					}
+					// Complete events, timed in microseconds.
+					file << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->thread
+						<< ",\"ts\":" << event.start.load(std::memory_order_relaxed) / 1000.0
+						<< ",\"dur\":" << event.duration.load(std::memory_order_relaxed) / 1000.0 << "}";
+					first = false;
+				}
+			}
+			file << "\n]}\n";
+			return static_cast<bool>(file);
+		}
+	}
+}
@@ -0,0 +1,251 @@
+#include <bench/Allocations.hpp>
+#include <network/Sockets.hpp>
+#include <network/event/Event.hpp>
+#include <network/event/Exchange.hpp>
+#include <network/handler/ReceptionHandler.hpp>
+#include <network/handler/SendingHandler.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+/*
+* @brief The 'send' & 'recv' calls made by the handlers, counted by interposing both functions before the C library.
+*/
+static size_t sends = 0;
+static size_t recvs = 0;
+
+#if defined(__linux__)
+static const bool COUNTED = true;
+
+extern "C" ssize_t send(int socket, const void* buffer, size_t length, int flags)
+{
+	++sends;
+	return syscall(SYS_sendto, socket, buffer, length, flags, nullptr, 0);
+}
+
+extern "C" ssize_t recv(int socket, void* buffer, size_t length, int flags)
+{
+	++recvs;
+	return syscall(SYS_recvfrom, socket, buffer, length, flags, nullptr, nullptr);
+}
+#else
+static const bool COUNTED = false;
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/*
+	* @brief The two connected ends of a transport.
+	*/
+	struct Pair
+	{
+		SOCKET sender = INVALID_SOCKET;
+		SOCKET receiver = INVALID_SOCKET;
+	};
+
+#if defined(__linux__)
+	/*
+	* @brief Connect a pair of local sockets, without any TCP/IP processing.
+	*/
+	bool local(Pair& pair)
+	{
+		int sockets[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+		{
+			return false;
+		}
+		pair.sender = sockets[0];
+		pair.receiver = sockets[1];
+		return true;
+	}
+#endif
+
+	/*
+	* @brief Connect a pair of TCP sockets over the loopback interface.
+	*/
+	bool loopback(Pair& pair)
+	{
+		SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (listener == INVALID_SOCKET)
+		{
+			return false;
+		}
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = 0; // any free port.
+		socklen_t length = sizeof(address);
+		bool connected = bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+			&& listen(listener, 1) == 0
+			&& getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) == 0;
+		if (connected)
+		{
+			pair.sender = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+			connected = pair.sender != INVALID_SOCKET
+				&& connect(pair.sender, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+		}
+		if (connected)
+		{
+			pair.receiver = accept(listener, nullptr, nullptr);
+			connected = pair.receiver != INVALID_SOCKET;
+		}
+		network::close(listener);
+		return connected;
+	}
+
+	/*
+	* @brief The measures of a benchmark.
+	*/
+	struct Measure
+	{
+		uint64_t messages = 0;
+		uint64_t bytes = 0; // the message bytes, without their headers.
+		double seconds = 0;
+		size_t sends = 0;
+		size_t recvs = 0;
+		size_t allocations = 0;
+		bool failed = false;
+	};
+
+	/*
+	* @brief Stream messages of a size from a sending handler to a reception handler, on a single thread.
+	*
+	* The sender keeps a window of messages in flight : each round enqueues up to the window, sends what the socket accepts, then receives what has arrived.
+	*/
+	Measure measure(const Pair& pair, unsigned int size, unsigned int window, double minimum)
+	{
+		network::handler::SendingHandler sender;
+		network::handler::ReceptionHandler receiver;
+		sender.initialize(pair.sender);
+		receiver.initialize(pair.receiver);
+		std::vector<network::PacketUnit> message(size, 0x5A);
+
+		Measure measure;
+		uint64_t enqueued = 0;
+		auto sends0 = sends;
+		auto recvs0 = recvs;
+		auto allocations = bench::allocations();
+		auto start = Clock::now();
+		while (measure.seconds < minimum)
+		{
+			// The clock is read once per window, not once per message.
+			auto target = measure.messages + window;
+			while (measure.messages < target)
+			{
+				for (; enqueued - measure.messages < window; ++enqueued)
+				{
+					sender.enqueue(message.data(), size);
+				}
+				sender.send();
+				while (auto const& event = receiver.receive())
+				{
+					if (!event->is<network::event::Exchange>() || event->as<network::event::Exchange>()->packet().size() != size)
+					{
+						measure.failed = true;
+						return measure;
+					}
+					++measure.messages;
+				}
+			}
+			measure.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+		measure.bytes = measure.messages * size;
+		measure.sends = sends - sends0;
+		measure.recvs = recvs - recvs0;
+		measure.allocations = bench::allocations() - allocations;
+		return measure;
+	}
+
+	void report(const std::string& benchmark, const Measure& measure)
+	{
+		std::cout << std::left << std::setw(24) << benchmark << std::right << std::fixed;
+		if (measure.failed)
+		{
+			std::cout << "  failed" << std::endl;
+			return;
+		}
+		std::cout << std::setw(14) << std::setprecision(0) << measure.messages / measure.seconds
+			<< std::setw(12) << std::setprecision(1) << measure.bytes / measure.seconds / 1024 / 1024;
+		if (COUNTED)
+		{
+			std::cout << std::setw(12) << std::setprecision(3) << static_cast<double>(measure.sends) / measure.messages
+				<< std::setw(12) << std::setprecision(3) << static_cast<double>(measure.recvs) / measure.messages;
+		}
+		else
+		{
+			std::cout << std::setw(12) << "n/a" << std::setw(12) << "n/a";
+		}
+		std::cout << std::setw(12) << std::setprecision(2) << static_cast<double>(measure.allocations) / measure.messages << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::cout << "Framing benchmark.\n";
+
+	// Only the benchmarks whose name holds the filter run, each one during at least the minimum time (in seconds), with a window of messages in flight.
+	std::string filter = argc > 1 ? argv[1] : "";
+	double minimum = argc > 2 ? std::stod(argv[2]) : 0.5;
+	unsigned int window = argc > 3 ? std::stoi(argv[3]) : 64;
+	if (window == 0)
+	{
+		std::cerr << "Usage: lifegame-framing-bench [filter] [minimum seconds] [window > 0]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!network::startup())
+	{
+		std::cerr << "Socket initialization error: " << network::error::latest() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	struct Transport
+	{
+		const char* name;
+		std::function<bool(Pair&)> connect;
+	};
+	std::vector<Transport> transports;
+#if defined(__linux__)
+	transports.push_back({ "socketpair", local });
+#endif
+	transports.push_back({ "loopback", loopback });
+
+	const unsigned int sizes[] = { 1, 16, 256, 4096, 65535 };
+
+	std::cout << std::left << std::setw(24) << "benchmark" << std::right << std::setw(14) << "msgs/s" << std::setw(12) << "MiB/s"
+		<< std::setw(12) << "sends/msg" << std::setw(12) << "recvs/msg" << std::setw(12) << "allocs/msg" << std::endl;
+
+	for (auto const& transport : transports)
+	{
+		for (auto size : sizes)
+		{
+			std::string benchmark = std::string(transport.name) + "/" + std::to_string(size);
+			if (benchmark.find(filter) == std::string::npos)
+			{
+				continue;
+			}
+			Pair pair;
+			if (!transport.connect(pair) || !network::nonBlocking(pair.sender) || !network::nonBlocking(pair.receiver))
+			{
+				std::cerr << benchmark << ": connection error: " << network::error::latest() << std::endl;
+				continue;
+			}
+			report(benchmark, measure(pair, size, window, minimum));
+			network::close(pair.sender);
+			network::close(pair.receiver);
+		}
+	}
+
+	network::shutdown();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <network/Client.hpp>
+#include <network/event/Event.hpp>
+#include <gateway/Router.hpp>
+#include <server/Server.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gateway
+{
+	/*
+	* @brief The gateway : clients connect to it as to a single server, & each one is routed to a backend server.
+	*
+	* The first request of a client picks its backend (see 'Router'), & a connection to the backend is opened for the client.
+	* Then the frames are forwarded as they are, both ways : their bodies are never parsed.
+	* A control connection to each backend asks for its statistics, to know its load & whether it is up.
+	*/
+	class Gateway
+	{
+	public:
+		/*
+		* @brief The address of a backend server.
+		*/
+		struct Address
+		{
+			std::string host;
+			unsigned short port = 0;
+		};
+
+		/*
+		* @brief Create a new gateway.
+		*
+		* @param front the server connecting the clients.
+		* @param backends the backend servers.
+		*/
+		Gateway(network::tcp::Server& front, const std::vector<Address>& backends);
+		Gateway(const Gateway& gateway) = delete;
+		Gateway& operator=(const Gateway& gateway) = delete;
+		Gateway(Gateway&& gateway) = delete;
+		Gateway& operator=(Gateway&& gateway) = delete;
+		~Gateway();
+
+		/*
+		* @brief Route & forward the frames of the clients.
+		*
+		* @param events the events, associated with each client id.
+		*/
+		void process(const std::map<uint64_t, std::unique_ptr<network::event::Event>>& events);
+
+		/*
+		* @brief Forward the frames of the backends, & poll their statistics.
+		*/
+		void update();
+
+	private:
+		/*
+		* @brief A backend server, & its control connection.
+		*/
+		struct Backend
+		{
+			Address address;
+			network::tcp::Client control;
+			bool connecting = false;
+			bool connected = false;
+			std::chrono::steady_clock::time_point polled; // the latest connection attempt or statistics request.
+		};
+
+		/*
+		* @brief A client, & its connection to its backend.
+		*/
+		struct Route
+		{
+			size_t backend = 0;
+			network::tcp::Client upstream;
+			bool connected = false;
+			bool closed = false; // the backend disconnected : the client is disconnected once the replies forwarded to it are sent.
+			std::vector<std::vector<uint8_t>> pending; // the frames of the client, until the backend is connected.
+			size_t pendingSize = 0; // the size of the pending frames, in bytes.
+		};
+
+		void receive(uint64_t client, const std::vector<uint8_t>& packet);
+		bool route(const std::vector<uint8_t>& packet, size_t& backend);
+		void forward(uint64_t client, Route& route);
+		void close(uint64_t client);
+		void poll(size_t b);
+		void report();
+
+		network::tcp::Server& front_;
+		std::vector<Backend> backends_;
+		Router router_;
+		std::map<uint64_t, Route> routes_;
+		std::chrono::steady_clock::time_point reported_;
+
+	};
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gateway
+{
+	/*
+	* @brief The choice of a backend server for each new session.
+	*
+	* Shared dishes are spread by consistent hashing of their name : every viewer of a dish reaches the same backend,
+	* & a backend joining or leaving only moves the dishes of its own share of the ring.
+	* Private dishes go to the least loaded backend : the sessions it last reported, plus the ones routed to it since.
+	* Resumed dishes go back to the backend they were created on, when known.
+	*/
+	class Router
+	{
+	public:
+		/*
+		* @brief The points of each backend on the ring : the more points, the more even the shares.
+		*/
+		static const unsigned int POINTS = 64;
+
+		/*
+		* @brief The most private sessions whose backend is remembered.
+		*/
+		static const size_t TOKENS = 1 << 20;
+
+		/*
+		* @brief Create a new router.
+		*
+		* @param backends the names of the backends, placing them on the ring : the same names always give the same shares.
+		*/
+		explicit Router(const std::vector<std::string>& backends);
+
+		/*
+		* @brief Mark a backend as available (or not) : an unavailable backend is never chosen.
+		*
+		* @param backend the backend.
+		* @param available whether (or not) the backend is available.
+		*/
+		void available(size_t backend, bool available);
+
+		/*
+		* @brief Update the load of a backend from its statistics.
+		*
+		* @param backend the backend.
+		* @param sessions the sessions the backend reported.
+		*/
+		void report(size_t backend, uint64_t sessions);
+
+		/*
+		* @brief Choose the least loaded available backend, for a private dish.
+		*
+		* @param backend the chosen backend.
+		*
+		* @return whether (or not) a backend is available.
+		*/
+		bool leastLoaded(size_t& backend);
+
+		/*
+		* @brief Choose the backend of a key, for a shared dish : the first available backend after the key on the ring.
+		*
+		* @param key the key, the name of the shared dish.
+		* @param backend the chosen backend.
+		*
+		* @return whether (or not) a backend is available.
+		*/
+		bool hashed(const std::string& key, size_t& backend);
+
+		/*
+		* @brief Remember the backend of a private session, to resume it there.
+		*
+		* @param token the session token.
+		* @param backend the backend.
+		*/
+		void remember(uint64_t token, size_t backend);
+
+		/*
+		* @brief Choose the backend a private session was created on, if known & available.
+		*
+		* @param token the session token.
+		* @param backend the chosen backend.
+		*
+		* @return whether (or not) the backend is known & available.
+		*/
+		bool remembered(uint64_t token, size_t& backend);
+
+		/*
+		* @return the load of a backend : its reported sessions, plus the ones routed to it since.
+		*/
+		uint64_t load(size_t backend) const;
+
+	private:
+		struct Backend
+		{
+			bool available = false;
+			uint64_t sessions = 0; // the last reported sessions.
+			uint64_t routed = 0; // the sessions routed since.
+		};
+
+		std::vector<Backend> backends_;
+		std::vector<std::pair<uint64_t, size_t>> ring_; // the points of the backends, sorted.
+		std::map<uint64_t, size_t> tokens_; // the backends of the private sessions.
+
+	};
+}
@@ -0,0 +1,62 @@
+#include <network/Sockets.hpp>
+#include <network/event/Event.hpp>
+#include <gateway/Gateway.hpp>
+#include <server/Server.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	std::cout << "Gateway.\n";
+
+	// The port of the clients, then the backends : 'host:port', or 'port' on this host.
+	if (argc <= 2)
+	{
+		std::cerr << "Usage: lifegame-gateway port backend..." << std::endl;
+		return EXIT_FAILURE;
+	}
+	auto port = static_cast<unsigned short>(std::stoi(argv[1]));
+	std::vector<gateway::Gateway::Address> backends;
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string backend(argv[i]);
+		auto colon = backend.rfind(':');
+		gateway::Gateway::Address address;
+		address.host = colon == std::string::npos ? "127.0.0.1" : backend.substr(0, colon);
+		address.port = static_cast<unsigned short>(std::stoi(colon == std::string::npos ? backend : backend.substr(colon + 1)));
+		backends.push_back(address);
+	}
+
+	if (!network::startup())
+	{
+		std::cerr << "Socket initialization error: " << network::error::latest() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	network::tcp::Server front;
+	if (!front.startup(port))
+	{
+		std::cerr << "Gateway connection error: " << network::error::latest() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	gateway::Gateway gateway(front, backends);
+
+	std::map<uint64_t, std::unique_ptr<network::event::Event>> events;
+	while (true)
+	{
+		events.clear();
+		front.process(events);
+		gateway.process(events);
+		gateway.update();
+	}
+
+	front.shutdown();
+
+	network::shutdown();
+
+	return EXIT_SUCCESS;
+}
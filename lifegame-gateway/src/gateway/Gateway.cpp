@@ -0,0 +1,313 @@
+#include <gateway/Gateway.hpp>
+#include <network/event/Connection.hpp>
+#include <network/event/Disconnection.hpp>
+#include <network/event/Exchange.hpp>
+#include <Protocol.hpp>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace gateway
+{
+	/*
+	* @brief The size of its sending queue above which the frames of a client's backend are no more forwarded : the backend throttles the client by itself.
+	*/
+	static const size_t HIGH_WATERMARK = 64 * 1024;
+
+	/*
+	* @brief The size of the frames of a client buffered while its backend connects, above which the client is disconnected.
+	*/
+	static const size_t PENDING_LIMIT = 64 * 1024;
+
+	/*
+	* @brief The delay between two statistics requests to a backend, or two connections to a down backend.
+	*/
+	static const std::chrono::seconds POLL_PERIOD(1);
+
+	/*
+	* @brief The delay between two reports of the backends load.
+	*/
+	static const std::chrono::seconds REPORT_PERIOD(10);
+
+	/*
+	* @brief The name of a backend, placing it on the ring.
+	*/
+	static std::vector<std::string> names(const std::vector<Gateway::Address>& backends)
+	{
+		std::vector<std::string> names;
+		for (auto const& backend : backends)
+		{
+			names.push_back(backend.host + ":" + std::to_string(backend.port));
+		}
+		return names;
+	}
+
+	Gateway::Gateway(network::tcp::Server& front, const std::vector<Address>& backends) :
+		front_(front), backends_(backends.size()), router_(names(backends)), reported_(std::chrono::steady_clock::now())
+	{
+		for (size_t b = 0; b < backends.size(); ++b)
+		{
+			backends_[b].address = backends[b];
+		}
+	}
+
+	Gateway::~Gateway() = default;
+
+	void Gateway::process(const std::map<uint64_t, std::unique_ptr<network::event::Event>>& events)
+	{
+		for (auto const& event : events)
+		{
+			auto client = event.first;
+			if (event.second->is<network::event::Disconnection>())
+			{
+				close(client);
+			}
+			else if (event.second->is<network::event::Exchange>())
+			{
+				receive(client, event.second->as<network::event::Exchange>()->packet());
+			}
+		}
+	}
+
+	void Gateway::update()
+	{
+		for (size_t b = 0; b < backends_.size(); ++b)
+		{
+			poll(b);
+		}
+		for (auto route = routes_.begin(); route != routes_.end();)
+		{
+			if (!route->second.closed)
+			{
+				forward(route->first, route->second);
+			}
+			// The replies of a closed backend are sent before disconnecting the client.
+			if (route->second.closed && front_.queueSize(route->first) == 0)
+			{
+				front_.disconnect(route->first);
+				route = routes_.erase(route);
+			}
+			else
+			{
+				++route;
+			}
+		}
+		report();
+	}
+
+	void Gateway::receive(uint64_t client, const std::vector<uint8_t>& packet)
+	{
+		auto known = routes_.find(client);
+		if (known == routes_.end())
+		{
+			// The first frame of a client picks its backend.
+			Route route;
+			if (!this->route(packet, route.backend))
+			{
+				std::cerr << "No backend available for: " << client << std::endl;
+				front_.disconnect(client);
+				return;
+			}
+			auto const& address = backends_[route.backend].address;
+			if (!route.upstream.connect(address.host, address.port))
+			{
+				std::cerr << "Backend connection error: " << network::error::latest() << std::endl;
+				front_.disconnect(client);
+				return;
+			}
+			std::cout << "Client " << client << " routed to backend: " << address.host << ":" << address.port << std::endl;
+			known = routes_.emplace(client, std::move(route)).first;
+		}
+
+		auto& route = known->second;
+		if (route.closed)
+		{
+			return;
+		}
+		else if (!route.connected)
+		{
+			route.pendingSize += packet.size();
+			if (route.pendingSize > PENDING_LIMIT)
+			{
+				std::cerr << "Too many frames pending for: " << client << std::endl;
+				close(client);
+				front_.disconnect(client);
+				return;
+			}
+			route.pending.push_back(packet);
+		}
+		else if (!route.upstream.send(packet.data(), static_cast<unsigned int>(packet.size())))
+		{
+			std::cerr << "Backend sending error: " << network::error::latest() << std::endl;
+		}
+	}
+
+	bool Gateway::route(const std::vector<uint8_t>& packet, size_t& backend)
+	{
+		// Only the request type, & the name or the token of the dish, are read.
+		auto request = packet.empty() ? lifegame::protocol::Request::Step : static_cast<lifegame::protocol::Request>(packet.front());
+		const size_t NAME = 7; // [Join, rows, columns, ratio, rate, rule, topology, name...]
+		const size_t TOKEN = 6; // [Resume, rows, columns, ratio, rule, topology, token]
+		uint64_t token;
+		if (request == lifegame::protocol::Request::Join && packet.size() > NAME)
+		{
+			return router_.hashed(std::string(packet.cbegin() + NAME, packet.cend()), backend);
+		}
+		else if (request == lifegame::protocol::Request::Resume && lifegame::protocol::token(packet, TOKEN, token) && router_.remembered(token, backend))
+		{
+			return true;
+		}
+		return router_.leastLoaded(backend);
+	}
+
+	void Gateway::forward(uint64_t client, Route& route)
+	{
+		while (front_.queueSize(client) < HIGH_WATERMARK)
+		{
+			auto const& event = route.upstream.process();
+			if (!event)
+			{
+				break;
+			}
+			else if (event->is<network::event::Connection>())
+			{
+				if (event->as<network::event::Connection>()->state() != network::event::Connection::State::Successfull)
+				{
+					std::cerr << "Backend connection error for: " << client << std::endl;
+					route.upstream.disconnect();
+					route.closed = true;
+					break;
+				}
+				route.connected = true;
+				for (auto const& packet : route.pending)
+				{
+					route.upstream.send(packet.data(), static_cast<unsigned int>(packet.size()));
+				}
+				route.pending.clear();
+				route.pendingSize = 0;
+			}
+			else if (event->is<network::event::Disconnection>())
+			{
+				route.upstream.disconnect();
+				route.closed = true;
+				break;
+			}
+			else if (event->is<network::event::Exchange>())
+			{
+				// A session token is remembered, to resume the session on the same backend : the other replies are forwarded unread.
+				auto const& packet = event->as<network::event::Exchange>()->packet();
+				uint64_t token;
+				if (!packet.empty() && packet.front() == static_cast<uint8_t>(lifegame::protocol::Reply::Session)
+					&& lifegame::protocol::token(packet, lifegame::protocol::REPLY_HEADER_SIZE, token))
+				{
+					router_.remember(token, route.backend);
+				}
+				if (!front_.send(client, packet.data(), static_cast<unsigned int>(packet.size())))
+				{
+					std::cerr << "Client sending error: " << network::error::latest() << std::endl;
+				}
+			}
+		}
+	}
+
+	void Gateway::close(uint64_t client)
+	{
+		auto known = routes_.find(client);
+		if (known != routes_.end())
+		{
+			known->second.upstream.disconnect();
+			routes_.erase(known);
+		}
+	}
+
+	void Gateway::poll(size_t b)
+	{
+		// A backend is available while its control connection is up, & its load is read from its statistics.
+		auto& backend = backends_[b];
+		auto now = std::chrono::steady_clock::now();
+		if (!backend.connecting && !backend.connected)
+		{
+			if (now - backend.polled < POLL_PERIOD && backend.polled != std::chrono::steady_clock::time_point())
+			{
+				return;
+			}
+			backend.polled = now;
+			backend.connecting = backend.control.connect(backend.address.host, backend.address.port);
+			if (!backend.connecting)
+			{
+				backend.control.disconnect();
+			}
+			return;
+		}
+
+		while (auto const& event = backend.control.process())
+		{
+			if (event->is<network::event::Connection>())
+			{
+				backend.connecting = false;
+				backend.connected = event->as<network::event::Connection>()->state() == network::event::Connection::State::Successfull;
+				if (!backend.connected)
+				{
+					backend.control.disconnect();
+					return;
+				}
+				std::cout << "Backend up: " << backend.address.host << ":" << backend.address.port << std::endl;
+				router_.available(b, true);
+				backend.polled = std::chrono::steady_clock::time_point();
+			}
+			else if (event->is<network::event::Disconnection>())
+			{
+				std::cerr << "Backend down: " << backend.address.host << ":" << backend.address.port << std::endl;
+				backend.connected = false;
+				backend.control.disconnect();
+				router_.available(b, false);
+				backend.polled = now;
+				return;
+			}
+			else if (event->is<network::event::Exchange>())
+			{
+				// The 'sessions' line of the statistics.
+				auto const& packet = event->as<network::event::Exchange>()->packet();
+				std::istringstream text(std::string(packet.cbegin() + (std::min)(packet.size(), static_cast<size_t>(lifegame::protocol::REPLY_HEADER_SIZE)), packet.cend()));
+				std::string name;
+				uint64_t value;
+				while (text >> name)
+				{
+					if (name == "sessions" && text >> value)
+					{
+						router_.report(b, value);
+						break;
+					}
+					std::getline(text, name);
+				}
+			}
+		}
+
+		if (backend.connected && now - backend.polled >= POLL_PERIOD)
+		{
+			backend.polled = now;
+			auto request = static_cast<uint8_t>(lifegame::protocol::Request::Stats);
+			backend.control.send(&request, sizeof(request));
+		}
+	}
+
+	void Gateway::report()
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (now - reported_ < REPORT_PERIOD)
+		{
+			return;
+		}
+		reported_ = now;
+		std::map<size_t, size_t> clients;
+		for (auto const& route : routes_)
+		{
+			++clients[route.second.backend];
+		}
+		for (size_t b = 0; b < backends_.size(); ++b)
+		{
+			std::cout << "Backend " << backends_[b].address.host << ":" << backends_[b].address.port << (backends_[b].connected ? " up" : " down")
+				<< ", load: " << router_.load(b) << ", clients: " << clients[b] << std::endl;
+		}
+	}
+}
@@ -0,0 +1,108 @@
+#include <gateway/Router.hpp>
+#include <algorithm>
+
+namespace gateway
+{
+	/*
+	* @brief Hash a key : FNV-1a, then a final mix so that close keys land far apart on the ring.
+	*/
+	static uint64_t hash(const std::string& key)
+	{
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (auto character : key)
+		{
+			hash = (hash ^ static_cast<uint8_t>(character)) * 0x100000001B3ull;
+		}
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	Router::Router(const std::vector<std::string>& backends) : backends_(backends.size())
+	{
+		for (size_t b = 0; b < backends.size(); ++b)
+		{
+			for (unsigned int p = 0; p < POINTS; ++p)
+			{
+				ring_.emplace_back(hash(backends[b] + "#" + std::to_string(p)), b);
+			}
+		}
+		std::sort(ring_.begin(), ring_.end());
+	}
+
+	void Router::available(size_t backend, bool available)
+	{
+		backends_.at(backend).available = available;
+	}
+
+	void Router::report(size_t backend, uint64_t sessions)
+	{
+		backends_.at(backend).sessions = sessions;
+		backends_.at(backend).routed = 0;
+	}
+
+	bool Router::leastLoaded(size_t& backend)
+	{
+		bool found = false;
+		for (size_t b = 0; b < backends_.size(); ++b)
+		{
+			if (backends_[b].available && (!found || load(b) < load(backend)))
+			{
+				backend = b;
+				found = true;
+			}
+		}
+		if (found)
+		{
+			++backends_[backend].routed;
+		}
+		return found;
+	}
+
+	bool Router::hashed(const std::string& key, size_t& backend)
+	{
+		auto point = std::lower_bound(ring_.cbegin(), ring_.cend(), std::make_pair(hash(key), static_cast<size_t>(0)));
+		for (size_t i = 0; i < ring_.size(); ++i, ++point)
+		{
+			if (point == ring_.cend())
+			{
+				point = ring_.cbegin();
+			}
+			if (backends_[point->second].available)
+			{
+				backend = point->second;
+				++backends_[backend].routed;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Router::remember(uint64_t token, size_t backend)
+	{
+		// Tokens are random : dropping the lowest one drops any of them, & a forgotten session is resumed on the least loaded backend.
+		if (tokens_.size() >= TOKENS && tokens_.find(token) == tokens_.end())
+		{
+			tokens_.erase(tokens_.begin());
+		}
+		tokens_[token] = backend;
+	}
+
+	bool Router::remembered(uint64_t token, size_t& backend)
+	{
+		auto known = tokens_.find(token);
+		if (known == tokens_.end() || !backends_[known->second].available)
+		{
+			return false;
+		}
+		backend = known->second;
+		++backends_[backend].routed;
+		return true;
+	}
+
+	uint64_t Router::load(size_t backend) const
+	{
+		return backends_.at(backend).sessions + backends_.at(backend).routed;
+	}
+}
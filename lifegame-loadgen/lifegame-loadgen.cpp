@@ -0,0 +1,230 @@
+#include <network/Client.hpp>
+#include <network/Sockets.hpp>
+#include <network/event/Connection.hpp>
+#include <network/event/Disconnection.hpp>
+#include <network/event/Event.hpp>
+#include <network/event/Exchange.hpp>
+#include <Protocol.hpp>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/*
+	* @brief A simulated client, stepping its private dish with a pipelining depth.
+	*/
+	struct Session
+	{
+		enum class State
+		{
+			Idle,
+			Connecting,
+			Creating,
+			Stepping,
+			Closed,
+		};
+
+		network::tcp::Client client;
+		State state = State::Idle;
+		std::deque<Clock::time_point> requests; // the send times of the steps waiting for their generation.
+	};
+
+	/*
+	* @brief Retrieve a quantile of sorted latencies.
+	*/
+	double quantile(const std::vector<uint32_t>& latencies, double quantile)
+	{
+		if (latencies.empty())
+		{
+			return 0;
+		}
+		auto rank = static_cast<size_t>(quantile * (latencies.size() - 1) + 0.5);
+		return latencies[rank] / 1000.0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::cout << "Load generator.\n";
+
+	// Numeric arguments, then the server address & port.
+	unsigned int clients = argc > 1 ? std::stoi(argv[1]) : 100; // the concurrent sessions.
+	int size = argc > 2 ? std::stoi(argv[2]) : 32; // the rows & columns of the dishes.
+	unsigned int depth = argc > 3 ? std::stoi(argv[3]) : 4; // the steps requested ahead of their reception, by each session.
+	double rampUp = argc > 4 ? std::stod(argv[4]) : 1.0; // the seconds to start every session.
+	double duration = argc > 5 ? std::stod(argv[5]) : 10.0; // the measured seconds, once every session started.
+	std::string address = argc > 6 ? argv[6] : "127.0.0.1";
+	unsigned short port = argc > 7 ? static_cast<unsigned short>(std::stoi(argv[7])) : 11000;
+	if (size <= 0 || size > lifegame::DIMENSION || depth == 0 || clients == 0)
+	{
+		std::cerr << "Usage: lifegame-loadgen [clients] [size in ]0, 253]] [depth > 0] [ramp-up seconds] [duration seconds] [address] [port]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "Sessions: " << clients << ", dishes: " << size << "x" << size << ", depth: " << depth << ", ramp-up: " << rampUp << " s, duration: " << duration << " s" << std::endl;
+
+#if defined(__linux__)
+	// Each session holds a socket : raising the open files limit as far as allowed.
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+#endif
+
+	if (!network::startup())
+	{
+		std::cerr << "Socket initialization error: " << network::error::latest() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Session> sessions(clients);
+	std::vector<uint32_t> latencies; // in microseconds, once measuring.
+	uint64_t generations = 0;
+	uint64_t bytes = 0;
+	uint64_t failures = 0;
+	uint64_t periodGenerations = 0;
+	size_t started = 0;
+
+	auto begin = Clock::now();
+	auto measureStart = begin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(rampUp));
+	auto measureEnd = measureStart + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+	auto reported = begin;
+	bool measuring = false;
+
+	while (true)
+	{
+		auto now = Clock::now();
+		if (now >= measureEnd)
+		{
+			break;
+		}
+		if (!measuring && now >= measureStart)
+		{
+			// Only the generations received once every session started are measured.
+			measuring = true;
+			generations = 0;
+			bytes = 0;
+		}
+
+		// Starting the sessions evenly along the ramp-up.
+		double elapsed = std::chrono::duration<double>(now - begin).count();
+		size_t due = rampUp <= 0 || elapsed >= rampUp ? clients : static_cast<size_t>(clients * elapsed / rampUp);
+		for (; started < due; ++started)
+		{
+			auto& session = sessions[started];
+			if (session.client.connect(address, port))
+			{
+				session.state = Session::State::Connecting;
+			}
+			else
+			{
+				session.state = Session::State::Closed;
+				++failures;
+			}
+		}
+
+		for (size_t s = 0; s < started; ++s)
+		{
+			auto& session = sessions[s];
+			if (session.state == Session::State::Closed)
+			{
+				continue;
+			}
+			while (auto const& event = session.client.process())
+			{
+				if (event->is<network::event::Connection>())
+				{
+					if (event->as<network::event::Connection>()->state() != network::event::Connection::State::Successfull)
+					{
+						session.state = Session::State::Closed;
+						++failures;
+						break;
+					}
+					network::PacketUnit create[] = { static_cast<network::PacketUnit>(lifegame::protocol::Request::Create), static_cast<network::PacketUnit>(size), static_cast<network::PacketUnit>(size), 35, static_cast<network::PacketUnit>(lifegame::Rule::Life), static_cast<network::PacketUnit>(lifegame::Topology::Bounded) };
+					session.client.send(create, sizeof(create));
+					session.state = Session::State::Creating;
+				}
+				else if (event->is<network::event::Exchange>())
+				{
+					auto const& packet = event->as<network::event::Exchange>()->packet();
+					lifegame::protocol::Reply reply;
+					uint32_t generation;
+					if (!lifegame::protocol::header(packet, reply, generation))
+					{
+						continue;
+					}
+					if (reply == lifegame::protocol::Reply::Seed)
+					{
+						session.state = Session::State::Stepping;
+					}
+					else if (lifegame::protocol::delta(reply) && !session.requests.empty())
+					{
+						if (measuring)
+						{
+							latencies.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - session.requests.front()).count()));
+						}
+						session.requests.pop_front();
+						++generations;
+						++periodGenerations;
+						bytes += packet.size() + network::tcp::HeaderSize;
+					}
+				}
+				else if (event->is<network::event::Disconnection>())
+				{
+					session.state = Session::State::Closed;
+					++failures;
+					break;
+				}
+			}
+
+			// Keeping the pipeline full.
+			while (session.state == Session::State::Stepping && session.requests.size() < depth)
+			{
+				network::PacketUnit step = static_cast<network::PacketUnit>(lifegame::protocol::Request::Step);
+				if (!session.client.send(&step, sizeof(step)))
+				{
+					break;
+				}
+				session.requests.push_back(Clock::now());
+			}
+		}
+
+		if (now - reported >= std::chrono::seconds(1))
+		{
+			auto stepping = std::count_if(sessions.cbegin(), sessions.cend(), [](const Session& session) {
+				return session.state == Session::State::Stepping;
+			});
+			std::cout << std::fixed << std::setprecision(1) << "t=" << elapsed << " s, sessions stepping: " << stepping << ", failures: " << failures
+				<< ", generations/s: " << periodGenerations / std::chrono::duration<double>(now - reported).count() << std::endl;
+			reported = now;
+			periodGenerations = 0;
+		}
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << std::fixed << std::setprecision(3)
+		<< "Generations: " << generations << " in " << duration << " s\n"
+		<< "Throughput: " << generations / duration << " generations/s, " << bytes / duration / 1024 / 1024 << " MiB/s\n"
+		<< "Step round trip (ms): p50=" << quantile(latencies, 0.5) << " p99=" << quantile(latencies, 0.99) << " p999=" << quantile(latencies, 0.999)
+		<< " max=" << (latencies.empty() ? 0 : latencies.back() / 1000.0) << "\n"
+		<< "Failures: " << failures << std::endl;
+
+	for (auto& session : sessions)
+	{
+		session.client.disconnect();
+	}
+	network::shutdown();
+
+	return EXIT_SUCCESS;
+}
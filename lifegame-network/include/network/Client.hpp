@@ -1,6 +1,7 @@
 #pragma once
 
 #include <network/Sockets.hpp>
+#include <network/Statistics.hpp>
 #include <network/event/Event.hpp>
 #include <memory>
 #include <string>
@@ -61,6 +62,16 @@ namespace network
 			*/
 			bool send(const PacketUnit* packet, unsigned int length);
 
+			/*
+			* @return the size of the data queue to be sent.
+			*/
+			size_t queueSize() const;
+
+			/*
+			* @return the traffic of the client.
+			*/
+			Statistics statistics() const;
+
 			/*
 			* @brief Process message sending & reception for the client.
 			*
@@ -15,6 +15,7 @@ namespace network
 	void close(SOCKET socket);
 	bool nonBlocking(SOCKET socket);
 	bool reuseAddress(SOCKET socket);
+	bool noDelay(SOCKET socket);
 	namespace error {
 		int latest();
 	}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace network
+{
+	/*
+	* @brief The traffic of a peer : messages are counted once fully received or sent, bytes include message headers.
+	*/
+	struct Statistics
+	{
+		uint64_t framesIn = 0;
+		uint64_t bytesIn = 0;
+		uint64_t framesOut = 0;
+		uint64_t bytesOut = 0;
+	};
+}
@@ -18,7 +18,7 @@ namespace network
 			Exchange(const std::vector<PacketUnit>& packet) : Event(Type::Exchange), packet_(packet)
 			{
 			}
-			std::vector<PacketUnit> packet() const;
+			const std::vector<PacketUnit>& packet() const;
 
 		private:
 			std::vector<PacketUnit> packet_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <network/Sockets.hpp>
+#include <network/Statistics.hpp>
 #include <network/event/Event.hpp>
 #include <memory>
 #include <vector>
@@ -39,6 +40,13 @@ namespace network
 			*/
 			std::unique_ptr<event::Event> receive();
 
+			/*
+			* @brief Add the received messages & bytes to the traffic of the peer.
+			*
+			* @param statistics the traffic of the peer.
+			*/
+			void count(Statistics& statistics) const;
+
 		private:
 			// TODO remove these private methods from the header ?
 			void prepareHeaderReception();
@@ -47,6 +55,8 @@ namespace network
 
 			std::vector<PacketUnit> buffer_;
 			unsigned int received_ = 0;
+			uint64_t frames_ = 0;
+			uint64_t bytes_ = 0;
 			SOCKET socket_ = INVALID_SOCKET;
 			State state_ = State::Header;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <network/Sockets.hpp>
+#include <network/Statistics.hpp>
 #include <network/event/Event.hpp>
 #include <list>
 #include <vector>
@@ -54,6 +55,13 @@ namespace network
 			*/
 			size_t queueSize() const;
 
+			/*
+			* @brief Add the sent messages & bytes to the traffic of the peer.
+			*
+			* @param statistics the traffic of the peer.
+			*/
+			void count(Statistics& statistics) const;
+
 		private:
 			// TODO remove these private methods from the header ?
 			bool sendBuffer();
@@ -64,6 +72,8 @@ namespace network
 			std::vector<PacketUnit> sendingBuffer_;
 			SOCKET socket_ = INVALID_SOCKET;
 			State state_ = State::Idle;
+			uint64_t frames_ = 0;
+			uint64_t bytes_ = 0;
 
 		};
 	}
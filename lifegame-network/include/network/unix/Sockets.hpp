@@ -2,10 +2,12 @@
 
 #include <sys/socket.h>
 #include <netinet/in.h> // sockaddr_in, IPPROTO_TCP
+#include <netinet/tcp.h> // TCP_NODELAY
 #include <arpa/inet.h> // hton*, ntoh*, inet_addr
 #include <unistd.h>  // close
 #include <cerrno> // errno
-#include <poll> // poll
+#include <fcntl.h> // fcntl
+#include <poll.h> // poll
 #define SOCKET int
 #define INVALID_SOCKET ((int)-1)
 #define SOCKET_ERROR (int(-1))
@@ -17,6 +19,7 @@ namespace network
 		enum
 		{
 			AGAIN = EAGAIN,
+			TRYAGAIN = EAGAIN,
 			WOULDBLOCK = EWOULDBLOCK,
 			INPROGRESS = EINPROGRESS,
 			INTR = EINTR,
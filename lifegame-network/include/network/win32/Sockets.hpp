@@ -6,6 +6,7 @@
 using nfds_t = unsigned long;
 using socklen_t = int;
 inline int poll(pollfd fdarray[], nfds_t nfds, int timeout) { return WSAPoll(fdarray, nfds, timeout); };
+#define MSG_NOSIGNAL 0 // a closed connection never raises a signal.
 
 namespace network
 {
@@ -34,6 +34,8 @@ namespace network
 			bool connect(const std::string& address, unsigned short port);
 			void disconnect();
 			bool send(const PacketUnit* packet, unsigned int length);
+			size_t queueSize() const;
+			Statistics statistics() const;
 			std::unique_ptr<event::Event> process();
 
 		private:
@@ -72,6 +74,8 @@ namespace network
 				disconnect();
 				return false;
 			}
+			// The sending handler already gathers the queued packets into a single send : small packets are not delayed any further.
+			noDelay(socket_);
 
 			sendingHandler_.initialize(socket_);
 			receivingHandler_.initialize(socket_);
@@ -96,6 +100,7 @@ namespace network
 				disconnect();
 				return false;
 			}
+			noDelay(socket_);
 			if (connectionHandler_.connect(socket_, address, port))
 			{
 				state_ = State::Connecting;
@@ -119,6 +124,19 @@ namespace network
 			return sendingHandler_.enqueue(packet, length);
 		}
 
+		size_t Client::ClientImpl::queueSize() const
+		{
+			return sendingHandler_.queueSize();
+		}
+
+		Statistics Client::ClientImpl::statistics() const
+		{
+			Statistics statistics;
+			receivingHandler_.count(statistics);
+			sendingHandler_.count(statistics);
+			return statistics;
+		}
+
 		std::unique_ptr<event::Event> Client::ClientImpl::process()
 		{
 			switch (state_)
@@ -210,6 +228,16 @@ namespace network
 			return impl_ && impl_->send(packet, length);
 		}
 
+		size_t Client::queueSize() const
+		{
+			return impl_ ? impl_->queueSize() : 0;
+		}
+
+		Statistics Client::statistics() const
+		{
+			return impl_ ? impl_->statistics() : Statistics();
+		}
+
 		std::unique_ptr<event::Event> Client::process()
 		{
 			return impl_ ? impl_->process() : nullptr;
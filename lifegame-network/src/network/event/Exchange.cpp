@@ -4,7 +4,7 @@ namespace network
 {
 	namespace event
 	{
-		std::vector<PacketUnit> Exchange::packet() const
+		const std::vector<PacketUnit>& Exchange::packet() const
 		{
 			return packet_;
 		}
@@ -36,12 +36,9 @@ namespace network
 			}
 			else if (result > 0)
 			{
+				// A refused connection is writable too : its errors are checked first.
 				short revents = descriptor_.revents;
-				if (revents & POLLOUT)
-				{
-					return std::make_unique<event::Connection>(event::Connection::State::Successfull);
-				}
-				else if (revents & (POLLHUP | POLLNVAL))
+				if (revents & (POLLHUP | POLLNVAL))
 				{
 					return std::make_unique<event::Connection>(event::Connection::State::Failed);
 				}
@@ -49,6 +46,10 @@ namespace network
 				{
 					return std::make_unique<event::Connection>(event::Connection::State::Failed);
 				}
+				else if (revents & POLLOUT)
+				{
+					return std::make_unique<event::Connection>(event::Connection::State::Successfull);
+				}
 				return nullptr;
 			}
 			return nullptr;
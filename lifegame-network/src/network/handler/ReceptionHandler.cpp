@@ -1,7 +1,10 @@
 #include <network/handler/ReceptionHandler.hpp>
 #include <network/event/Disconnection.hpp>
 #include <network/event/Exchange.hpp>
+#include <Metrics.hpp>
+#include <Trace.hpp>
 #include <assert.h>
+#include <cstring>
 
 #include <iostream>
 
@@ -9,6 +12,9 @@ namespace network
 {
 	namespace handler
 	{
+		static lifegame::metrics::Counter framesIn("network.frames.in");
+		static lifegame::metrics::Counter bytesIn("network.bytes.in");
+
 		void ReceptionHandler::initialize(SOCKET socket)
 		{
 			assert(socket != INVALID_SOCKET);
@@ -18,6 +24,7 @@ namespace network
 
 		std::unique_ptr<event::Event> ReceptionHandler::receive()
 		{
+			LIFEGAME_TRACE("ReceptionHandler::receive");
 			assert(socket_ != INVALID_SOCKET);
 			int length = buffer_.size() - received_;
 			PacketUnit* buffer = buffer_.data() + received_;
@@ -25,10 +32,14 @@ namespace network
 			if (received > 0) // Reception.
 			{
 				received_ += received;
+				bytes_ += received;
+				bytesIn.add(received);
 				if (received_ == buffer_.size())
 				{
 					if (state_ == State::Body)
 					{
+						++frames_;
+						framesIn.add();
 						std::unique_ptr<event::Event> message = std::make_unique<event::Exchange>(std::move(buffer_));
 						prepareHeaderReception();
 						return message;
@@ -60,6 +71,12 @@ namespace network
 			}
 		}
 
+		void ReceptionHandler::count(Statistics& statistics) const
+		{
+			statistics.framesIn += frames_;
+			statistics.bytesIn += bytes_;
+		}
+
 		void ReceptionHandler::prepareHeaderReception()
 		{
 			prepareReception(tcp::HeaderSize, State::Header);
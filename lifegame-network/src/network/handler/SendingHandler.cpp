@@ -1,12 +1,20 @@
 #include <network/handler/SendingHandler.hpp>
+#include <Metrics.hpp>
+#include <Trace.hpp>
 #include <assert.h>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 namespace network
 {
 	namespace handler
 	{
+		static lifegame::metrics::Counter framesOut("network.frames.out");
+		static lifegame::metrics::Counter bytesOut("network.bytes.out");
+		static lifegame::metrics::Histogram queueDepth("network.queue.depth");
+
 		void SendingHandler::initialize(SOCKET socket)
 		{
 			queueingBuffers_.clear();
@@ -21,11 +29,13 @@ namespace network
 				return false;
 			}
 			queueingBuffers_.emplace_back(packet, packet + length);
+			queueDepth.record(queueingBuffers_.size());
 			return true;
 		}
 
 		void SendingHandler::send()
 		{
+			LIFEGAME_TRACE("SendingHandler::send");
 			assert(socket_ != INVALID_SOCKET);
 			if (state_ == State::Idle && !queueingBuffers_.empty())
 			{
@@ -40,6 +50,8 @@ namespace network
 				}
 				else
 				{
+					++frames_;
+					framesOut.add();
 					if (!queueingBuffers_.empty())
 					{
 						prepareHeaderSending();
@@ -59,9 +71,11 @@ namespace network
 			}
 
 			// Send data based on previous send.
-			int sent = ::send(socket_, reinterpret_cast<const char*>(sendingBuffer_.data()), sendingBuffer_.size(), 0);
+			int sent = ::send(socket_, reinterpret_cast<const char*>(sendingBuffer_.data()), sendingBuffer_.size(), MSG_NOSIGNAL); // a peer gone away is an error, not a signal killing the process.
 			if (sent > 0)
 			{
+				bytes_ += sent;
+				bytesOut.add(sent);
 				if (sent == sendingBuffer_.size())
 				{
 					// All data have been sent.
@@ -70,9 +84,8 @@ namespace network
 				}
 				else
 				{
-					// Partial data send.
-					memmove(sendingBuffer_.data() + sent, sendingBuffer_.data(), sent);
-					sendingBuffer_.erase(sendingBuffer_.cbegin() + sent, sendingBuffer_.cend());
+					// Partial data send : keeping the data left to send.
+					sendingBuffer_.erase(sendingBuffer_.cbegin(), sendingBuffer_.cbegin() + sent);
 				}
 			}
 			return false;
@@ -97,6 +110,12 @@ namespace network
 			state_ = State::Body;
 		}
 
+		void SendingHandler::count(Statistics& statistics) const
+		{
+			statistics.framesOut += frames_;
+			statistics.bytesOut += bytes_;
+		}
+
 		size_t SendingHandler::queueSize() const
 		{
 			size_t size = std::accumulate(
@@ -22,6 +22,11 @@ namespace network
 		int optval = 1;
 		return setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval)) == 0;
 	}
+	bool noDelay(SOCKET socket)
+	{
+		int optval = 1;
+		return setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &optval, sizeof(optval)) == 0;
+	}
 	namespace error {
 		int latest()
 		{
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief Bound the data queued for a client reading slower than its dish lives.
+	*
+	* Once its sending queue goes above the high watermark, the client is throttled until the queue goes below the low watermark.
+	* Meanwhile, its dish either stops living ('Pause'), or keeps on living with its deltas merged into a single net delta ('Coalesce').
+	*/
+	class Backpressure
+	{
+	public:
+		enum class Policy
+		{
+			Pause,
+			Coalesce,
+		};
+
+		/*
+		* @brief Create a new backpressure state.
+		*
+		* @param policy the policy applied while the client is throttled.
+		* @param high the sending queue size above which the client is throttled.
+		* @param low the sending queue size below which the client is no more throttled.
+		*/
+		Backpressure(Policy policy = Policy::Coalesce, size_t high = 64 * 1024, size_t low = 16 * 1024);
+
+		/*
+		* @brief Update the throttling state of the client.
+		*
+		* @param queueSize the size of the client sending queue.
+		*
+		* @return whether (or not) the client is throttled.
+		*/
+		bool throttle(size_t queueSize);
+
+		/*
+		* @return whether (or not) the client is throttled.
+		*/
+		bool throttled() const;
+
+		/*
+		* @return the policy applied while the client is throttled.
+		*/
+		Policy policy() const;
+
+		/*
+		* @brief Merge a delta reply into the held net delta.
+		*
+		* A cell whose state changed twice is back to its former state, & is dropped from the net delta.
+		*
+		* @param reply the delta reply.
+		*/
+		void merge(const std::vector<uint8_t>& reply);
+
+		/*
+		* @return whether (or not) a net delta is held.
+		*/
+		bool backlogged() const;
+
+		/*
+		* @brief Release the held net delta.
+		* Its triples can outgrow a frame (up to 3 bytes per living cell) : the reply is meant to be encoded before sending (see 'protocol::delta').
+		*
+		* @param reply the net delta reply, tagged with the generation of the latest merged delta, its cells row after row.
+		*/
+		void flush(std::vector<uint8_t>& reply);
+
+		/*
+		* @brief Drop the held net delta, when superseded by a snapshot.
+		*/
+		void clear();
+
+	private:
+		Policy policy_;
+		size_t high_;
+		size_t low_;
+		bool throttled_ = false;
+		bool backlogged_ = false;
+		uint32_t generation_ = 0;
+		std::map<uint16_t, uint8_t> cells_; // the changed cells, by 'row' then 'column' coordinates.
+
+	};
+}
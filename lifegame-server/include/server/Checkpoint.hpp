@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Dish.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief A checkpoint of the living dishes, saved to a file which is mapped back into memory when the server restarts.
+	*
+	* The file holds fixed-size structures read in place, in the byte order of the machine :
+	* a header, a table of records (one per dish), then for each record its name & its packed cells, aligned on 8 bytes.
+	* A file written by another machine or another version is rejected as a whole.
+	*/
+	class Checkpoint
+	{
+	public:
+		/*
+		* @brief A restored dish.
+		*/
+		struct Entry
+		{
+			uint64_t token = 0; // '0' for a shared dish.
+			std::string name; // empty for a private dish.
+			uint32_t generation = 0;
+			lifegame::Rule rule = lifegame::Rule::Life;
+			std::unique_ptr<lifegame::Dish> dish;
+		};
+
+		/*
+		* @brief Add a dish to the checkpoint.
+		*
+		* @param token the session token of a private dish, '0' for a shared one.
+		* @param name the name of a shared dish, empty for a private one.
+		* @param generation the generation of the dish.
+		* @param rule the rule the dish lives by.
+		* @param dish the dish.
+		*/
+		void add(const uint64_t token, const std::string& name, const uint32_t generation, const lifegame::Rule rule, const lifegame::Dish& dish);
+
+		/*
+		* @return the number of dishes in the checkpoint.
+		*/
+		size_t size() const;
+
+		/*
+		* @brief Save the checkpoint, replacing the previous one only once fully written.
+		*
+		* @param path the path of the file.
+		*
+		* @return whether (or not) the checkpoint has been saved.
+		*/
+		bool save(const std::string& path) const;
+
+		/*
+		* @brief Restore the dishes of a saved checkpoint.
+		*
+		* @param path the path of the file.
+		* @param entries the restored dishes.
+		*
+		* @return whether (or not) the checkpoint has been restored.
+		*/
+		static bool load(const std::string& path, std::vector<Entry>& entries);
+
+	private:
+		struct Record
+		{
+			uint64_t token;
+			uint64_t offset; // the position of the name, followed by the packed cells.
+			uint32_t generation;
+			uint32_t length; // the length of the packed cells.
+			uint16_t name; // the length of the name.
+			uint8_t rows;
+			uint8_t columns;
+			uint8_t rule; // '0' (the Life rule) in the checkpoints written before rules.
+			uint8_t topology; // '0' (bounded) in the checkpoints written before topologies.
+			uint8_t reserved[2];
+		};
+
+		std::vector<Record> records_;
+		std::vector<uint8_t> data_; // the names & packed cells, from the end of the records table.
+
+	};
+}
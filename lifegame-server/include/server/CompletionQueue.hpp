@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace server
+{
+	/*
+	* @brief A lock-free, unbounded queue with many producers & a single consumer.
+	*
+	* Workers push their results without waiting for each other, the network thread pops them.
+	*/
+	template<typename T> class CompletionQueue
+	{
+	public:
+		CompletionQueue() : head_(new Node()), tail_(head_.load(std::memory_order_relaxed))
+		{
+		}
+		CompletionQueue(const CompletionQueue& queue) = delete;
+		CompletionQueue& operator=(const CompletionQueue& queue) = delete;
+		CompletionQueue(CompletionQueue&& queue) = delete;
+		CompletionQueue& operator=(CompletionQueue&& queue) = delete;
+		~CompletionQueue()
+		{
+			T value;
+			while (pop(value))
+			{
+			}
+			delete tail_;
+		}
+
+		/*
+		* @brief Enqueue a value. May be called from any thread.
+		*
+		* @param value the value.
+		*/
+		void push(T&& value)
+		{
+			Node* node = new Node();
+			node->value = std::move(value);
+			Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+			previous->next.store(node, std::memory_order_release);
+		}
+
+		/*
+		* @brief Dequeue the oldest value. Must be called from the consumer thread only.
+		*
+		* @param value the dequeued value.
+		*
+		* @return whether (or not) a value has been dequeued.
+		*/
+		bool pop(T& value)
+		{
+			Node* next = tail_->next.load(std::memory_order_acquire);
+			if (next == nullptr)
+			{
+				return false;
+			}
+			value = std::move(next->value);
+			delete tail_;
+			tail_ = next; // The dequeued node becomes the new stub.
+			return true;
+		}
+
+	private:
+		struct Node
+		{
+			std::atomic<Node*> next{ nullptr };
+			T value;
+		};
+
+		std::atomic<Node*> head_; // the latest pushed node, shared by producers.
+		Node* tail_; // the stub node, owned by the consumer.
+
+	};
+}
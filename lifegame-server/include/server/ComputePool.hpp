@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief A pool of worker threads computing tasks away from the network thread.
+	*
+	* Each worker owns a task queue. Tasks are spread over the queues in a round-robin way,
+	* and an idle worker steals tasks from the other queues : a long task only delays its own worker.
+	*/
+	class ComputePool
+	{
+	public:
+		using Task = std::function<void()>;
+
+		/*
+		* @brief Start the pool with a given number of workers.
+		*
+		* @param workers the number of worker threads. '0' stands for the hardware concurrency.
+		*/
+		explicit ComputePool(unsigned int workers = 0);
+		ComputePool(const ComputePool& pool) = delete;
+		ComputePool& operator=(const ComputePool& pool) = delete;
+		ComputePool(ComputePool&& pool) = delete;
+		ComputePool& operator=(ComputePool&& pool) = delete;
+		~ComputePool();
+
+		/*
+		* @brief Enqueue a task to be computed by a worker.
+		*
+		* @param task the task.
+		*/
+		void submit(Task&& task);
+
+		/*
+		* @return the number of worker threads.
+		*/
+		unsigned int workers() const;
+
+	private:
+		struct Worker
+		{
+			std::deque<Task> tasks;
+			std::mutex mutex;
+		};
+
+		void run(unsigned int index);
+		bool pop(unsigned int index, Task& task);
+		bool steal(unsigned int index, Task& task);
+
+		std::vector<std::unique_ptr<Worker>> workers_;
+		std::vector<std::thread> threads_;
+		std::atomic<unsigned int> next_{ 0 };
+		std::atomic<size_t> pending_{ 0 };
+		std::mutex sleeping_;
+		std::condition_variable wakeup_;
+		bool stopping_ = false;
+
+	};
+}
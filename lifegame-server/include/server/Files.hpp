@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+namespace server
+{
+	/*
+	* @brief Replace a file by another one, written aside : the file is flushed to disk, then renamed over the replaced one at once.
+	* Readers & crashes see either the previous file or the new one, never a partial or a missing file.
+	*
+	* @param temporary the path of the file written aside, on the same file system.
+	* @param path the path of the replaced file.
+	*
+	* @return whether (or not) the file has been replaced.
+	*/
+	bool replace(const std::string& temporary, const std::string& path);
+}
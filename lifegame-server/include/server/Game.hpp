@@ -0,0 +1,167 @@
+#pragma once
+
+#include <network/event/Event.hpp>
+#include <server/Backpressure.hpp>
+#include <server/Checkpoint.hpp>
+#include <server/CompletionQueue.hpp>
+#include <server/ComputePool.hpp>
+#include <server/GenerationCache.hpp>
+#include <server/GenerationLog.hpp>
+#include <server/Server.hpp>
+#include <server/SlotMap.hpp>
+#include <server/TickScheduler.hpp>
+#include <Dish.hpp>
+#include <Metrics.hpp>
+#include <Random.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief The game : dishes living in sessions, watched by clients.
+	*
+	* A private session is created by a client, & lives on its demand or at the rate it subscribed to.
+	* A shared session is named, lives at its own rate, & is watched by any number of clients : each generation is computed once,
+	* then sent to every viewer.
+	*
+	* The dishes are checkpointed periodically : a restarted server restores them, & their clients resume them with their session token.
+	* The generations of private dishes may be logged, for their clients to seek any of them.
+	*/
+	class Game
+	{
+	public:
+		/*
+		* @brief Create a new game.
+		*
+		* @param server the server connecting the clients.
+		* @param policy the policy applied to throttled clients of private sessions.
+		* @param checkpoint the path of the checkpoint file to restore the dishes from & save them to, empty for none.
+		* @param logs the directory of the generation logs of private dishes, empty for none.
+		* @param stats the path of the file the metrics are periodically written to, empty for none.
+		* @param engine the engine computing the generations.
+		*/
+		Game(network::tcp::Server& server, Backpressure::Policy policy, const std::string& checkpoint, const std::string& logs, const std::string& stats, lifegame::Engine engine);
+		Game(const Game& game) = delete;
+		Game& operator=(const Game& game) = delete;
+		Game(Game&& game) = delete;
+		Game& operator=(Game&& game) = delete;
+		~Game();
+
+		/*
+		* @brief Process the events of the clients.
+		*
+		* @param events the events, associated with each client id.
+		*/
+		void process(const std::map<uint64_t, std::unique_ptr<network::event::Event>>& events);
+
+		/*
+		* @brief Send the computed generations, release the throttled clients which caught up, let subscribed dishes live, & checkpoint them.
+		*/
+		void update();
+
+	private:
+		/*
+		* @brief A living dish.
+		*
+		* While a dish is computed by the pool, it is owned by the computation : 'computing' is set, 'dish' & 'log' are empty.
+		*/
+		struct Session
+		{
+			std::string name; // empty for a private session.
+			uint64_t token = 0; // the token to resume a private session with, '0' for a shared session.
+			lifegame::Rule rule = lifegame::Rule::Life;
+			std::unique_ptr<lifegame::Dish> dish;
+			Fingerprint fingerprint; // the fingerprint of the dish, once computed.
+			uint32_t generation = 0; // the generation of the dish, once computed.
+			bool computing = false;
+			std::deque<uint8_t> steps; // the generations of the steps asked for while computing or paused.
+			std::unique_ptr<GenerationLog> log; // empty for a shared session, or when generations are not logged.
+			bool seeking = false; // a seek asked for while computing.
+			uint32_t seek = 0; // the generation to seek.
+			std::vector<uint64_t> viewers; // the clients receiving the generations.
+			std::vector<uint64_t> joining; // the clients waiting for a snapshot, before receiving the generations.
+		};
+
+		/*
+		* @brief A connected client.
+		*/
+		struct Viewer
+		{
+			uint64_t session = 0; // '0' until the client creates or joins a session.
+			bool snapshot = false; // a snapshot asked for while computing.
+			Backpressure backpressure;
+		};
+
+		/*
+		* @brief The result of a computation, handed back to the network thread.
+		*/
+		struct Completion
+		{
+			uint64_t session = 0;
+			lifegame::Rule rule = lifegame::Rule::Life;
+			std::unique_ptr<lifegame::Dish> dish;
+			Fingerprint fingerprint;
+			std::unique_ptr<GenerationLog> log;
+			std::vector<uint8_t> reply; // the delta reply, as triples.
+			std::vector<uint8_t> encoded; // the delta reply in its smallest encoding, ready to be sent.
+		};
+
+		void connect(uint64_t client);
+		void disconnect(uint64_t client);
+		void receive(uint64_t client, const std::vector<uint8_t>& packet);
+		void create(uint64_t client, Viewer& viewer, const std::vector<uint8_t>& packet);
+		void join(uint64_t client, Viewer& viewer, const std::vector<uint8_t>& packet);
+		void resume(uint64_t client, Viewer& viewer, const std::vector<uint8_t>& packet);
+		void die(uint64_t id, const Session& session);
+		void live(uint64_t id, Session& session, uint8_t stride = 1);
+		void complete(Completion& completion);
+		void deliver(uint64_t client, Viewer& viewer, const Session& session, const Completion& completion);
+		void snapshot(uint64_t client, const Session& session);
+		void seek(Session& session);
+		void log(Session& session);
+		void send(uint64_t client, const std::vector<uint8_t>& packet);
+		bool paused(const Session& session);
+		void release();
+		void tick();
+		void report();
+		void statistics(std::string& text);
+		void restore();
+		void expire();
+		void checkpoint();
+		void checkpoint(uint64_t id, const Session* session);
+		void save();
+
+		network::tcp::Server& server_;
+		Backpressure::Policy policy_;
+		lifegame::Engine engine_;
+		CompletionQueue<Completion> completions_;
+		GenerationCache cache_;
+		std::string path_; // the checkpoint file.
+		std::string logs_; // the generation logs directory.
+		std::atomic<bool> saving_{ false }; // a checkpoint is being saved by the pool.
+		ComputePool pool_; // Stopped before the completion queue, the cache & the checkpoint state are destroyed.
+		TickScheduler scheduler_; // Ticks by session id.
+		lifegame::Random seeds_;
+		lifegame::Random secrets_; // Session tokens, drawn apart from the seeds sent to clients.
+		SlotMap<Session> sessions_;
+		SecondaryMap<Viewer> viewers_; // Viewers share the ids of their clients.
+		std::map<std::string, uint64_t> names_; // Shared sessions by name.
+		std::map<uint64_t, uint64_t> tokens_; // Private sessions by token.
+		std::vector<uint64_t> ticks_;
+		std::string stats_; // the metrics file.
+		std::vector<lifegame::metrics::CounterValue> counters_; // the counters at the latest report, for their rates.
+		std::chrono::steady_clock::time_point reported_;
+		std::chrono::steady_clock::time_point checkpointed_;
+		std::unique_ptr<Checkpoint> checkpoint_; // the checkpoint being built, waiting for the dishes being computed.
+		std::vector<uint64_t> pending_; // the sessions the checkpoint is waiting for.
+		bool restoring_ = false; // restored sessions wait for their clients until the expiry.
+		std::chrono::steady_clock::time_point expiry_;
+
+	};
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <Dish.hpp>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief A 128-bit hash of the cells of a dish.
+	*
+	* Each living cell has its own random 128-bit key, & the fingerprint XORs the keys of the alive cells (Zobrist hashing) :
+	* a delta updates it in O(delta) rather than O(dish).
+	*/
+	struct Fingerprint
+	{
+		uint64_t high = 0;
+		uint64_t low = 0;
+
+		/*
+		* @brief Compute the fingerprint of a dish.
+		*
+		* @param dish the dish.
+		*
+		* @return the fingerprint.
+		*/
+		static Fingerprint of(const lifegame::Dish& dish);
+
+		/*
+		* @brief Update the fingerprint with the cells whose state has changed.
+		*
+		* @param cells the cells : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param offset the position of the first cell.
+		*/
+		void update(const std::vector<uint8_t>& cells, size_t offset = 0);
+
+		/*
+		* @brief Toggle a cell in the fingerprint.
+		*
+		* @param row the "row" coordinate (= y) of the cell.
+		* @param column the "column" coordinate (= x) of the cell.
+		*/
+		void toggle(const uint8_t row, const uint8_t column);
+
+		bool operator==(const Fingerprint& other) const
+		{
+			return high == other.high && low == other.low;
+		}
+	};
+
+	/*
+	* @brief A bounded, least-recently-used cache of the next generation of dishes, shared by the compute pool workers.
+	*
+	* Identical dishes living under the same rule have the same next generation : it is computed once, then read from the cache.
+	*/
+	class GenerationCache
+	{
+	public:
+		/*
+		* @brief The key of a dish : its sizes, its rule, its topology & its fingerprint, with the generations to live.
+		*/
+		struct Key
+		{
+			Fingerprint fingerprint;
+			uint8_t rows = 0;
+			uint8_t columns = 0;
+			uint32_t rule = 0;
+			lifegame::Topology topology = lifegame::Topology::Bounded;
+			uint8_t generations = 1; // the generations lived at once.
+
+			bool operator==(const Key& other) const
+			{
+				return fingerprint == other.fingerprint && rows == other.rows && columns == other.columns && rule == other.rule && topology == other.topology
+					&& generations == other.generations;
+			}
+		};
+
+		/*
+		* @brief Create a new cache.
+		*
+		* @param capacity the maximum memory used by the cache, in bytes.
+		*/
+		explicit GenerationCache(size_t capacity = 64 * 1024 * 1024);
+		GenerationCache(const GenerationCache& cache) = delete;
+		GenerationCache& operator=(const GenerationCache& cache) = delete;
+
+		/*
+		* @brief Look the next generation of a dish up.
+		*
+		* @param key the key of the dish.
+		* @param cells the cells whose state changes in the next generation, if found.
+		*
+		* @return whether (or not) the next generation has been found.
+		*/
+		bool find(const Key& key, std::vector<uint8_t>& cells);
+
+		/*
+		* @brief Store the next generation of a dish, evicting the least recently used ones as needed.
+		*
+		* @param key the key of the dish.
+		* @param cells the cells whose state changes in the next generation.
+		*/
+		void insert(const Key& key, std::vector<uint8_t>&& cells);
+
+		/*
+		* @brief The cache usage.
+		*/
+		struct Statistics
+		{
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+			size_t entries = 0;
+			size_t memory = 0; // in bytes.
+
+			/*
+			* @return the ratio of lookups found in the cache, in [0, 1].
+			*/
+			double hitRate() const;
+		};
+
+		/*
+		* @return the cache usage.
+		*/
+		Statistics statistics() const;
+
+	private:
+		struct Hash
+		{
+			size_t operator()(const Key& key) const;
+		};
+
+		struct Entry
+		{
+			Key key;
+			std::vector<uint8_t> cells;
+		};
+
+		static size_t footprint(const Entry& entry);
+
+		mutable std::mutex mutex_;
+		std::list<Entry> entries_; // from the most to the least recently used.
+		std::unordered_map<Key, std::list<Entry>::iterator, Hash> index_;
+		size_t capacity_;
+		Statistics statistics_;
+
+	};
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Dish.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief An append-only log of the generations of a dish, to replay it from any logged generation.
+	*
+	* The log file is a sequence of records : [type, generation (4 bytes, big endian), length (4 bytes, big endian), payload...].
+	* A keyframe holds every cell of the dish ([rows, columns, packed states...], see 'Dish::pack'), a delta holds the cells whose state
+	* has changed since the previous logged generation (see 'Dish::live') : a step of several generations at once is logged as a single delta.
+	* A keyframe is written every 'interval' logged steps, & whenever a step does not start from the latest logged generation : a generation is
+	* rebuilt from the closest keyframe plus at most 'interval' deltas. The index file lists the keyframes : [generation (4 bytes, big endian), offset (8 bytes, big endian)].
+	*
+	* Records are buffered in memory & written once per keyframe, so that a log holds no file open between writes.
+	*/
+	class GenerationLog
+	{
+	public:
+		/*
+		* @brief Create a new log.
+		*
+		* @param path the path of the log file, the index file path adding '.idx' to it.
+		* @param interval the number of logged steps between two keyframes.
+		*/
+		GenerationLog(const std::string& path, const uint32_t interval = 64);
+		GenerationLog(const GenerationLog& log) = delete;
+		GenerationLog& operator=(const GenerationLog& log) = delete;
+		~GenerationLog();
+
+		/*
+		* @brief Read the index of an existing log, dropping a record left incomplete by a crash.
+		*
+		* @return whether (or not) the log can be appended to.
+		*/
+		bool open();
+
+		/*
+		* @brief Append a generation to the log, unless already logged : a dish lives the same way when replayed.
+		*
+		* @param generation the generation of the dish.
+		* @param stride the number of generations lived since the cells were computed, '0' to log the whole dish.
+		* @param cells the cells whose state has changed since the generation 'generation - stride' : first 'row' coordinate, second 'column' coordinate, third cell state.
+		* @param offset the position of the first cell.
+		* @param dish the dish, at the given generation.
+		*/
+		void append(const uint32_t generation, const uint32_t stride, const std::vector<uint8_t>& cells, const size_t offset, const lifegame::Dish& dish);
+
+		/*
+		* @brief Write the buffered records.
+		*
+		* @return whether (or not) the records have been written.
+		*/
+		bool flush();
+
+		/*
+		* @brief Rebuild a logged generation of the dish, reading only from the closest keyframe.
+		* Generations are logged per step : the generations lived inside a step of several generations cannot be seeked.
+		*
+		* @param generation the generation.
+		*
+		* @return the dish at the given generation, 'nullptr' if the generation is not logged.
+		*/
+		std::unique_ptr<lifegame::Dish> seek(const uint32_t generation);
+
+		/*
+		* @return whether (or not) a generation has been logged.
+		*/
+		bool empty() const;
+
+		/*
+		* @return the latest logged generation.
+		*/
+		uint32_t latest() const;
+
+	private:
+		enum class Record : uint8_t
+		{
+			Keyframe = 0,
+			Delta = 1,
+		};
+
+		struct Keyframe
+		{
+			uint32_t generation;
+			uint64_t offset;
+		};
+
+		void record(const Record type, const uint32_t generation, const std::vector<uint8_t>& payload, const size_t offset);
+
+		std::string path_;
+		uint32_t interval_;
+		std::vector<Keyframe> keyframes_;
+		std::vector<uint8_t> records_; // the records not written yet.
+		std::vector<uint8_t> index_; // the keyframes not written yet.
+		uint64_t size_ = 0; // the size of the written records.
+		uint32_t latest_ = 0;
+		uint32_t deltas_ = 0; // the deltas logged since the latest keyframe.
+		bool failed_ = false;
+
+	};
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace server
+{
+	/*
+	* @brief A file mapped into memory, read-only.
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile();
+		MappedFile(const MappedFile& file) = delete;
+		MappedFile& operator=(const MappedFile& file) = delete;
+		MappedFile(MappedFile&& file) noexcept;
+		MappedFile& operator=(MappedFile&& file) noexcept;
+		~MappedFile();
+
+		/*
+		* @brief Map a file, unmapping the previous one.
+		*
+		* @param path the path of the file.
+		*
+		* @return whether (or not) the file has been mapped.
+		*/
+		bool open(const std::string& path);
+
+		/*
+		* @brief Unmap the file.
+		*/
+		void close();
+
+		/*
+		* @return the content of the file, 'nullptr' if no file is mapped.
+		*/
+		const uint8_t* data() const;
+
+		/*
+		* @return the size of the file, in bytes.
+		*/
+		size_t size() const;
+
+	private:
+		class MappedFileImpl;
+		std::unique_ptr<MappedFileImpl> impl_;
+
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <network/Sockets.hpp>
+#include <network/Statistics.hpp>
 #include <network/event/Event.hpp>
 #include <map>
 #include <memory>
@@ -36,10 +37,17 @@ namespace network
 			*/
 			void shutdown();
 
+			/*
+			* @brief Disconnect a client, without any disconnection event.
+			*
+			* @param clientid the client.
+			*/
+			void disconnect(uint64_t clientid);
+
 			/*
 			* @brief Process message sending & reception for the server.
 			*
-			* @param the messages to receive, associated with each client.
+			* @param the messages to receive, associated with each client id. A client id is never reused.
 			*/
 			void process(std::map<uint64_t, std::unique_ptr<event::Event>>& events);
 
@@ -64,6 +72,24 @@ namespace network
 			*/
 			bool send(const PacketUnit* packet, unsigned int length);
 
+			/*
+			* @brief Retrieve the size of the data queue to be sent to a client.
+			*
+			* @param clientid the client.
+			*
+			* @return the size of the data queue, '0' for an unknown client.
+			*/
+			size_t queueSize(uint64_t clientid) const;
+
+			/*
+			* @brief Retrieve the traffic of a client.
+			*
+			* @param clientid the client.
+			*
+			* @return the traffic of the client, empty for an unknown client.
+			*/
+			Statistics statistics(uint64_t clientid) const;
+
 		private:
 			class ServerImpl;
 			std::unique_ptr<ServerImpl> impl_;
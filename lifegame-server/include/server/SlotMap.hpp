@@ -0,0 +1,235 @@
+#pragma once
+
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief The ids of a slot map : the slot index in the low 32 bits, the slot generation in the high 32 bits.
+	*
+	* A slot generation changes each time its value is erased, so that an id is never reused.
+	*/
+	namespace slot
+	{
+		inline uint32_t index(uint64_t id)
+		{
+			return static_cast<uint32_t>(id);
+		}
+		inline uint32_t generation(uint64_t id)
+		{
+			return static_cast<uint32_t>(id >> 32);
+		}
+		inline uint64_t id(uint32_t index, uint32_t generation)
+		{
+			return (static_cast<uint64_t>(generation) << 32) | index;
+		}
+	}
+
+	/*
+	* @brief A table of values stored contiguously, reached in O(1) through their slot.
+	*
+	* Values are iterated by position, from '0' to 'size()'. Erasing a value moves the last one into its position.
+	*/
+	template<typename T> class SlotTable
+	{
+	public:
+		/*
+		* @return the value with the given id, 'nullptr' if none.
+		*/
+		T* find(uint64_t id)
+		{
+			auto index = slot::index(id);
+			if (index >= slots_.size())
+			{
+				return nullptr;
+			}
+			const Slot& slot = slots_[index];
+			if (slot.position == VACANT || slot.generation != slot::generation(id))
+			{
+				return nullptr;
+			}
+			return &values_[slot.position];
+		}
+
+		const T* find(uint64_t id) const
+		{
+			return const_cast<SlotTable*>(this)->find(id);
+		}
+
+		/*
+		* @return the number of values.
+		*/
+		size_t size() const
+		{
+			return values_.size();
+		}
+
+		/*
+		* @return the id of the value at the given position.
+		*/
+		uint64_t key(size_t position) const
+		{
+			return keys_[position];
+		}
+
+		/*
+		* @return the value at the given position.
+		*/
+		T& value(size_t position)
+		{
+			return values_[position];
+		}
+
+		/*
+		* @brief Erase all the values.
+		*/
+		void clear()
+		{
+			while (!keys_.empty())
+			{
+				erase(keys_.back());
+			}
+		}
+
+		/*
+		* @brief Erase a value.
+		*
+		* @param id the id of the value.
+		*
+		* @return whether (or not) a value has been erased.
+		*/
+		bool erase(uint64_t id)
+		{
+			if (find(id) == nullptr)
+			{
+				return false;
+			}
+			Slot& slot = slots_[slot::index(id)];
+			auto position = slot.position;
+			if (position != values_.size() - 1)
+			{
+				values_[position] = std::move(values_.back());
+				keys_[position] = keys_.back();
+				slots_[slot::index(keys_[position])].position = position;
+			}
+			values_.pop_back();
+			keys_.pop_back();
+			slot.position = VACANT;
+			vacate(slot::index(id));
+			return true;
+		}
+
+	protected:
+		static const uint32_t VACANT = UINT32_MAX;
+
+		struct Slot
+		{
+			uint32_t generation = 0;
+			uint32_t position = VACANT;
+		};
+
+		virtual ~SlotTable() = default;
+
+		/*
+		* @brief Store a value into a vacant slot.
+		*/
+		void occupy(uint32_t index, uint32_t generation, T&& value)
+		{
+			if (index >= slots_.size())
+			{
+				slots_.resize(index + 1);
+			}
+			Slot& slot = slots_[index];
+			assert(slot.position == VACANT);
+			slot.generation = generation;
+			slot.position = static_cast<uint32_t>(values_.size());
+			values_.push_back(std::move(value));
+			keys_.push_back(slot::id(index, generation));
+		}
+
+		/*
+		* @brief Called once a slot has been vacated.
+		*/
+		virtual void vacate(uint32_t /* index */)
+		{
+		}
+
+		std::vector<Slot> slots_;
+		std::vector<T> values_;
+		std::vector<uint64_t> keys_;
+
+	};
+
+	/*
+	* @brief A slot table issuing the ids of its values.
+	*/
+	template<typename T> class SlotMap : public SlotTable<T>
+	{
+	public:
+		/*
+		* @brief Insert a value.
+		*
+		* @param value the value.
+		*
+		* @return the id of the value.
+		*/
+		uint64_t insert(T&& value)
+		{
+			uint32_t index;
+			if (free_.empty())
+			{
+				index = static_cast<uint32_t>(this->slots_.size());
+			}
+			else
+			{
+				index = free_.back();
+				free_.pop_back();
+			}
+			uint32_t generation = index < this->slots_.size() ? this->slots_[index].generation : 1;
+			this->occupy(index, generation, std::move(value));
+			return slot::id(index, generation);
+		}
+
+	protected:
+		void vacate(uint32_t index) override
+		{
+			++this->slots_[index].generation;
+			free_.push_back(index);
+		}
+
+	private:
+		std::vector<uint32_t> free_;
+
+	};
+
+	/*
+	* @brief A slot table storing values alongside the ones of a slot map, with the same ids.
+	*/
+	template<typename T> class SecondaryMap : public SlotTable<T>
+	{
+	public:
+		/*
+		* @brief Insert a value, replacing the one of a former id of the same slot.
+		*
+		* @param id the id, issued by a slot map.
+		* @param value the value.
+		*
+		* @return the inserted value.
+		*/
+		T& insert(uint64_t id, T&& value)
+		{
+			auto index = slot::index(id);
+			if (index < this->slots_.size() && this->slots_[index].position != SlotTable<T>::VACANT)
+			{
+				this->erase(slot::id(index, this->slots_[index].generation));
+			}
+			this->occupy(index, slot::generation(id), std::move(value));
+			return *this->find(id);
+		}
+
+	};
+}
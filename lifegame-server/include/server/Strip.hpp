@@ -0,0 +1,110 @@
+#pragma once
+
+#include <network/Client.hpp>
+#include <server/ComputePool.hpp>
+#include <server/Server.hpp>
+#include <Dish.hpp>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief A strip of a dish too large for a single process : a band of its rows, living beside the strips above & below it, each in its own process.
+	*
+	* The strips are chained : each one accepts the strip above it on 'port + index', & connects to the strip below it on 'port + index + 1'.
+	* On a torus, the last strip connects to the first one, & the columns wrap within each strip.
+	*
+	* Each generation, a strip sends its first row to the strip above & its last row to the strip below, then computes its inner rows on the
+	* compute pool while the rows of its neighbours (its halo, one row on each side) arrive : only its first & last rows wait for them.
+	*/
+	class Strip
+	{
+	public:
+		/*
+		* @brief The placement of a strip in the dish.
+		*/
+		struct Layout
+		{
+			unsigned int index = 0; // the strip, from the top of the dish.
+			unsigned int count = 1; // the number of strips.
+			std::string address = "127.0.0.1"; // the address of the strip below.
+			unsigned short port = 12000; // the port of the first strip.
+		};
+
+		/*
+		* @brief Create a new strip, drawn from a seed of its own : the seed of the dish, mixed with the index of the strip.
+		*
+		* @param layout the placement of the strip.
+		* @param rows the rows of the strip.
+		* @param columns the columns of the dish.
+		* @param ratio the ratio of alive cells.
+		* @param seed the seed of the dish.
+		* @param rule the rule of the dish.
+		* @param topology the topology of the dish.
+		*/
+		Strip(const Layout& layout, uint8_t rows, uint8_t columns, uint8_t ratio, uint64_t seed, lifegame::Rule rule, lifegame::Topology topology);
+		Strip(const Strip& strip) = delete;
+		Strip& operator=(const Strip& strip) = delete;
+		Strip(Strip&& strip) = delete;
+		Strip& operator=(Strip&& strip) = delete;
+		~Strip();
+
+		/*
+		* @brief Connect the strip to its neighbours, waiting for them to start up.
+		*
+		* @return whether (or not) the strip has been connected.
+		*/
+		bool startup();
+
+		/*
+		* @brief Send the rows still queued for the neighbours, then disconnect from them.
+		*/
+		void shutdown();
+
+		/*
+		* @brief Let the strip live a generation, along with its neighbours.
+		*
+		* @return whether (or not) the generation has been lived : a neighbour may have disconnected, or sent rows of another width.
+		*/
+		bool live();
+
+		/*
+		* @return the generation of the strip.
+		*/
+		uint32_t generation() const;
+
+		/*
+		* @return the cells of the strip, its halo included.
+		*/
+		const lifegame::Dish& dish() const;
+
+	private:
+		bool above() const;
+		bool below() const;
+		void receive();
+		void send(uint8_t row, bool upward);
+
+		Layout layout_;
+		lifegame::Rule rule_;
+		lifegame::Dish dish_;
+		uint32_t generation_ = 0;
+		network::tcp::Server server_; // connected to the strip above.
+		uint64_t upper_ = 0; // the strip above, once connected.
+		bool accepted_ = false;
+		network::tcp::Client client_; // connected to the strip below.
+		bool connected_ = false;
+		bool failed_ = false; // a neighbour sent a row of another width.
+		std::map<uint32_t, std::vector<uint8_t>> uppers_; // the rows received from the strip above, by generation.
+		std::map<uint32_t, std::vector<uint8_t>> lowers_; // the rows received from the strip below, by generation.
+		std::vector<std::vector<uint8_t>> changes_; // the cells computed by each task.
+		std::mutex mutex_;
+		std::condition_variable done_;
+		unsigned int pending_ = 0; // the tasks still computing.
+		ComputePool pool_;
+
+	};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <queue>
+#include <vector>
+
+namespace server
+{
+	/*
+	* @brief Schedule periodic ticks for subscribers, each one at its own rate.
+	*/
+	class TickScheduler
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		/*
+		* @brief Subscribe (or re-subscribe) to periodic ticks.
+		*
+		* @param subscriber the subscriber.
+		* @param rate the number of ticks per second.
+		* @param now the current time, the first tick is due one period later.
+		*/
+		void subscribe(uint64_t subscriber, unsigned int rate, Clock::time_point now);
+
+		/*
+		* @brief Stop the ticks of a subscriber.
+		*
+		* @param subscriber the subscriber.
+		*/
+		void unsubscribe(uint64_t subscriber);
+
+		/*
+		* @brief Retrieve the subscribers whose tick is due, & schedule their next tick.
+		*
+		* @param now the current time.
+		* @param subscribers the subscribers whose tick is due.
+		*/
+		void due(Clock::time_point now, std::vector<uint64_t>& subscribers);
+
+	private:
+		struct Tick
+		{
+			Clock::time_point time;
+			uint64_t subscriber;
+			uint64_t version;
+			bool operator>(const Tick& other) const
+			{
+				return time > other.time;
+			}
+		};
+
+		struct Subscription
+		{
+			Clock::duration period;
+			uint64_t version;
+		};
+
+		// Ticks of cancelled subscriptions are discarded lazily, when reaching the top of the queue.
+		std::priority_queue<Tick, std::vector<Tick>, std::greater<Tick>> ticks_;
+		std::map<uint64_t, Subscription> subscriptions_;
+		uint64_t versions_ = 0;
+
+	};
+}
@@ -1,20 +1,160 @@
 #include <network/Sockets.hpp>
-#include <network/event/Connection.hpp>
-#include <network/event/Disconnection.hpp>
 #include <network/event/Event.hpp>
-#include <network/event/Exchange.hpp>
+#include <server/Backpressure.hpp>
+#include <server/Game.hpp>
+#include <server/GenerationCache.hpp>
 #include <server/Server.hpp>
-#include <Cell.hpp>
-#include <Dish.hpp>
-#include <assert.h>
+#include <server/Strip.hpp>
+#include <Metrics.hpp>
+#include <Trace.hpp>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <map>
-#include <vector>
+#include <string>
 
-int main()
+/*
+* @brief Let a strip of a dish too large for a single process live, beside the strips of the other processes.
+*
+* Arguments : strip index count rows columns [ratio] [seed] [generations] [rule] [topology] [address] [port].
+* Every strip process is given the same arguments but its index, '0' generations standing for no end.
+*/
+static int strip(int argc, char* argv[])
+{
+	if (argc < 6)
+	{
+		std::cerr << "Usage: lifegame-server strip index count rows columns [ratio] [seed] [generations] [rule] [topology] [address] [port]" << std::endl;
+		return EXIT_FAILURE;
+	}
+	server::Strip::Layout layout;
+	layout.index = std::stoi(argv[2]);
+	layout.count = std::stoi(argv[3]);
+	int rows = std::stoi(argv[4]);
+	int columns = std::stoi(argv[5]);
+	int ratio = argc > 6 ? std::stoi(argv[6]) : 35;
+	uint64_t seed = argc > 7 ? std::stoull(argv[7]) : 1;
+	uint32_t generations = argc > 8 ? std::stoul(argv[8]) : 0;
+	auto rule = lifegame::Rule::Life;
+	if (argc > 9 && !lifegame::rule(argv[9], rule))
+	{
+		std::cerr << "Unknown rule: " << argv[9] << std::endl;
+		return EXIT_FAILURE;
+	}
+	auto topology = lifegame::Topology::Bounded;
+	if (argc > 10 && !lifegame::topology(argv[10], topology))
+	{
+		std::cerr << "Unknown topology: " << argv[10] << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (argc > 11)
+	{
+		layout.address = argv[11];
+	}
+	if (argc > 12)
+	{
+		layout.port = static_cast<unsigned short>(std::stoi(argv[12]));
+	}
+	if (layout.count == 0 || layout.index >= layout.count || rows <= 0 || rows > 253 || columns <= 0 || columns > 253)
+	{
+		std::cerr << "Strip not in the dish, or not in ]0, 253] rows & columns: " << layout.index << "/" << layout.count << ", " << rows << " x " << columns << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!network::startup())
+	{
+		std::cout << "Socket initialization error: " << network::error::latest();
+		return EXIT_FAILURE;
+	}
+
+	int status = EXIT_SUCCESS;
+	{
+		server::Strip strip(layout, static_cast<uint8_t>(rows), static_cast<uint8_t>(columns), static_cast<uint8_t>(ratio), seed, rule, topology);
+		std::cout << "Strip " << layout.index << "/" << layout.count << " of " << rows << " x " << columns << " cells, waiting for its neighbours." << std::endl;
+		if (!strip.startup())
+		{
+			std::cerr << "Strip connection error: " << network::error::latest() << std::endl;
+			status = EXIT_FAILURE;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		auto reported = start;
+		while (status == EXIT_SUCCESS && (generations == 0 || strip.generation() < generations))
+		{
+			if (!strip.live())
+			{
+				status = EXIT_FAILURE;
+			}
+			auto now = std::chrono::steady_clock::now();
+			if (now - reported >= std::chrono::seconds(10))
+			{
+				reported = now;
+				std::vector<lifegame::metrics::CounterValue> counters;
+				std::vector<lifegame::metrics::HistogramValue> histograms;
+				lifegame::metrics::collect(counters, histograms);
+				std::string text;
+				lifegame::metrics::write(counters, histograms, text);
+				std::cout << "Strip generation: " << strip.generation() << "\n" << text << std::flush;
+			}
+		}
+		strip.shutdown();
+
+		// The strips of a dish are checked against a single process by their alive cells & their fingerprint.
+		auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		auto fingerprint = server::Fingerprint::of(strip.dish());
+		size_t alive = 0;
+		for (auto r = 1; r < strip.dish().rows() - 1; ++r)
+		{
+			for (auto c = 1; c < strip.dish().columns() - 1; ++c)
+			{
+				alive += strip.dish().alive(r, c);
+			}
+		}
+		std::cout << "Strip " << layout.index << " lived " << strip.generation() << " generations in " << elapsed << " s, alive cells: " << alive
+			<< ", fingerprint: " << std::hex << std::setfill('0') << std::setw(16) << fingerprint.high << std::setw(16) << fingerprint.low << std::dec << std::endl;
+	}
+
+	network::shutdown();
+
+	return status;
+}
+
+int main(int argc, char* argv[])
 {
 	std::cerr << "Server.\n";
 
+	// A strip of a dish spread over several processes, instead of the game.
+	if (argc > 1 && std::string(argv[1]) == "strip")
+	{
+		return strip(argc, argv);
+	}
+
+	// While a client of a private dish is throttled, the dish either pauses or keeps on living with coalesced deltas.
+	auto policy = server::Backpressure::Policy::Coalesce;
+	if (argc > 1 && std::string(argv[1]) == "pause")
+	{
+		policy = server::Backpressure::Policy::Pause;
+	}
+
+	// Dishes are checkpointed to a file, & restored from it on startup.
+	std::string checkpoint = argc > 2 ? argv[2] : "lifegame-server.checkpoint";
+
+	// The generations of private dishes are logged into a directory, if any, to seek them.
+	std::string logs = argc > 3 ? argv[3] : "";
+
+	// The metrics are periodically written to a file, if any.
+	std::string stats = argc > 4 ? argv[4] : "";
+
+	// The generations are computed by 2 x 2 blocks, unless another engine is given.
+	auto engine = lifegame::Engine::Blocks;
+	if (argc > 5 && !lifegame::engine(argv[5], engine))
+	{
+		std::cerr << "Unknown engine: " << argv[5] << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// The clients connect on port 11000, unless another one is given : several servers behind a gateway.
+	unsigned short port = argc > 6 ? static_cast<unsigned short>(std::stoi(argv[6])) : 11000;
+
 	if (!network::startup())
 	{
 		std::cout << "Socket initialization error: " << network::error::latest();
@@ -22,89 +162,38 @@ int main()
 	}
 
 	network::tcp::Server server;
-	if (!server.startup(11000))
+	if (!server.startup(port))
 	{
 		std::cerr << "Server connection error: " << network::error::latest();
 		return EXIT_FAILURE;
 	}
 
-	std::map<uint64_t, std::unique_ptr<lifegame::Dish>> dishes;
+	server::Game game(server, policy, checkpoint, logs, stats, engine);
+
+	// With tracing compiled in, a slow tick dumps the latest spans of every thread, at most once per period.
+	const auto slowTick = std::chrono::milliseconds(50);
+	const auto dumpPeriod = std::chrono::seconds(10);
+	std::chrono::steady_clock::time_point dumped;
 
 	std::map<uint64_t, std::unique_ptr<network::event::Event>> events;
 	while (true)
 	{
-		events.clear();
-		server.process(events);
-		for (auto const& event : events)
+		auto start = lifegame::trace::ENABLED ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
 		{
-			uint64_t client = event.first;
-			if (event.second->is<network::event::Connection>())
-			{
-				auto iterator = dishes.find(client);
-				if (iterator == dishes.end())
-				{
-					std::cout << "Dish booked for: " << client << std::endl;
-					dishes[client] = nullptr;
-				}
-				else
-				{
-					std::cerr << "Dish already booked for: " << client << std::endl;
-				}
-			}
-			else if (event.second->is<network::event::Disconnection>())
-			{
-				auto iterator = dishes.find(client);
-				if (iterator != dishes.end())
-				{
-					std::cout << "Dish dies for: " << client << std::endl;
-					dishes.erase(client);
-				}
-				else
-				{
-					std::cerr << "No dish to die for: " << client << std::endl;
-				}
-			}
-			else if (event.second->is<network::event::Exchange>())
+			LIFEGAME_TRACE("tick");
+			events.clear();
+			server.process(events);
+			game.process(events);
+			game.update();
+		}
+		if (lifegame::trace::ENABLED)
+		{
+			auto end = std::chrono::steady_clock::now();
+			if (end - start > slowTick && (dumped == std::chrono::steady_clock::time_point() || end - dumped > dumpPeriod))
 			{
-				auto iterator = dishes.find(client);
-				if (iterator != dishes.end())
-				{
-					std::vector<uint8_t> cells;
-
-					auto& dish = iterator->second;
-					if (dish == nullptr) {
-						std::cout << "Dish borns for: " << client << std::endl;
-						auto exchange = event.second->as<network::event::Exchange>();
-						std::vector<network::PacketUnit> packet = exchange->packet();
-						assert(packet.size() == 3);
-						auto dish = std::make_unique<lifegame::Dish>(packet.at(0), packet.at(1), packet.at(2));
-						dish->cells(cells);
-						dishes[client] = std::move(dish);
-					}
-					else
-					{
-						std::cout << "Dish lives for: " << client << std::endl;
-						dish->live(cells);
-					}
-
-					if (cells.size() == 0)
-					{
-						std::cout << "Dish sleeps for: " << client << std::endl;
-					}
-					else
-					{
-						// Sending next step to client.
-						if (!server.send(client, cells.data(), static_cast<unsigned int>(cells.size())))
-						{
-							std::cerr << "Server sending error: " << network::error::latest() << std::endl;
-							break;
-						}
-					}
-				}
-				else
-				{
-					std::cerr << "No dish to live for: " << client << std::endl;
-				}
+				dumped = end;
+				auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+				std::cout << "Slow tick of " << elapsed << " ms, trace dumped: " << (lifegame::trace::dump("lifegame-server.trace.json") ? "yes" : "no") << std::endl;
 			}
 		}
 	}
@@ -114,4 +203,4 @@ int main()
 	network::shutdown();
 
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -0,0 +1,89 @@
+#include <server/Backpressure.hpp>
+#include <Protocol.hpp>
+#include <assert.h>
+
+namespace server
+{
+	Backpressure::Backpressure(Policy policy, size_t high, size_t low) : policy_(policy), high_(high), low_(low)
+	{
+		assert(low_ <= high_);
+	}
+
+	bool Backpressure::throttle(size_t queueSize)
+	{
+		if (queueSize > high_)
+		{
+			throttled_ = true;
+		}
+		else if (queueSize < low_)
+		{
+			throttled_ = false;
+		}
+		return throttled_;
+	}
+
+	bool Backpressure::throttled() const
+	{
+		return throttled_;
+	}
+
+	Backpressure::Policy Backpressure::policy() const
+	{
+		return policy_;
+	}
+
+	void Backpressure::merge(const std::vector<uint8_t>& reply)
+	{
+		lifegame::protocol::Reply type;
+		uint32_t generation;
+		bool valid = lifegame::protocol::header(reply, type, generation);
+		assert(valid && type == lifegame::protocol::Reply::Delta);
+		if (!valid)
+		{
+			return;
+		}
+
+		assert((reply.size() - lifegame::protocol::REPLY_HEADER_SIZE) % 3 == 0);
+		for (size_t i = lifegame::protocol::REPLY_HEADER_SIZE; i + 2 < reply.size(); i = i + 3)
+		{
+			uint16_t key = static_cast<uint16_t>((reply[i] << 8) | reply[i + 1]);
+			auto iterator = cells_.find(key);
+			if (iterator == cells_.end())
+			{
+				cells_[key] = reply[i + 2];
+			}
+			else
+			{
+				// A cell only appears in a delta when its state changes : a second change cancels the first one.
+				cells_.erase(iterator);
+			}
+		}
+		generation_ = generation;
+		backlogged_ = true;
+	}
+
+	bool Backpressure::backlogged() const
+	{
+		return backlogged_;
+	}
+
+	void Backpressure::flush(std::vector<uint8_t>& reply)
+	{
+		assert(backlogged_);
+		lifegame::protocol::header(lifegame::protocol::Reply::Delta, generation_, reply);
+		for (auto const& cell : cells_)
+		{
+			reply.push_back(static_cast<uint8_t>(cell.first >> 8));
+			reply.push_back(static_cast<uint8_t>(cell.first));
+			reply.push_back(cell.second);
+		}
+		cells_.clear();
+		backlogged_ = false;
+	}
+
+	void Backpressure::clear()
+	{
+		cells_.clear();
+		backlogged_ = false;
+	}
+}
@@ -0,0 +1,140 @@
+#include <server/Checkpoint.hpp>
+#include <server/Files.hpp>
+#include <server/MappedFile.hpp>
+#include <algorithm>
+#include <assert.h>
+#include <fstream>
+
+namespace server
+{
+	/*
+	* @brief The header of a checkpoint file.
+	*/
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t order; // 'ORDER' as written by the machine, to detect a byte order mismatch.
+		uint64_t count; // the number of records.
+	};
+
+	static const char MAGIC[8] = { 'L', 'I', 'F', 'E', 'D', 'I', 'S', 'H' };
+	static const uint32_t VERSION = 1;
+	static const uint32_t ORDER = 0x01020304;
+	static const size_t ALIGNMENT = 8;
+	static_assert(sizeof(Header) % ALIGNMENT == 0, "Records must be aligned.");
+
+	static size_t align(size_t size)
+	{
+		return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	}
+
+	void Checkpoint::add(const uint64_t token, const std::string& name, const uint32_t generation, const lifegame::Rule rule, const lifegame::Dish& dish)
+	{
+		assert(name.size() <= UINT16_MAX);
+		Record record = {};
+		record.token = token;
+		record.offset = data_.size();
+		record.generation = generation;
+		record.name = static_cast<uint16_t>((std::min)(name.size(), static_cast<size_t>(UINT16_MAX)));
+		record.rows = dish.rows() - 2;
+		record.columns = dish.columns() - 2;
+		record.rule = static_cast<uint8_t>(rule);
+		record.topology = static_cast<uint8_t>(dish.topology());
+		data_.insert(data_.end(), name.cbegin(), name.cbegin() + record.name);
+		dish.pack(data_);
+		record.length = static_cast<uint32_t>(data_.size() - record.offset - record.name);
+		data_.resize(align(data_.size()), 0);
+		records_.push_back(record);
+	}
+
+	size_t Checkpoint::size() const
+	{
+		return records_.size();
+	}
+
+	bool Checkpoint::save(const std::string& path) const
+	{
+		Header header = {};
+		std::copy(std::begin(MAGIC), std::end(MAGIC), header.magic);
+		header.version = VERSION;
+		header.order = ORDER;
+		header.count = records_.size();
+
+		// Offsets are relative to the end of the records table.
+		std::vector<Record> records(records_);
+		uint64_t base = sizeof(Header) + records.size() * sizeof(Record);
+		for (auto& record : records)
+		{
+			record.offset += base;
+		}
+
+		// Written aside, flushed to disk, then renamed over the previous checkpoint : a crash while saving leaves it intact.
+		std::string temporary = path + ".tmp";
+		{
+			std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+			file.write(reinterpret_cast<const char*>(data_.data()), data_.size());
+			file.flush();
+			if (!file)
+			{
+				return false;
+			}
+		}
+		return replace(temporary, path);
+	}
+
+	bool Checkpoint::load(const std::string& path, std::vector<Entry>& entries)
+	{
+		MappedFile file;
+		if (!file.open(path) || file.size() < sizeof(Header))
+		{
+			return false;
+		}
+
+		auto data = file.data();
+		auto header = reinterpret_cast<const Header*>(data);
+		if (!std::equal(std::begin(MAGIC), std::end(MAGIC), header->magic) || header->version != VERSION || header->order != ORDER)
+		{
+			return false;
+		}
+		if (header->count > (file.size() - sizeof(Header)) / sizeof(Record))
+		{
+			return false;
+		}
+
+		// Checking every record before restoring any of them.
+		auto records = reinterpret_cast<const Record*>(data + sizeof(Header));
+		for (uint64_t i = 0; i < header->count; ++i)
+		{
+			auto& record = records[i];
+			auto end = record.offset + record.name + record.length;
+			if (record.offset > file.size() || end < record.offset || end > file.size()
+				|| record.rows == 0 || record.rows > lifegame::DIMENSION || record.columns == 0 || record.columns > lifegame::DIMENSION
+				|| record.rule >= lifegame::RULES || record.topology >= lifegame::TOPOLOGIES
+				|| record.length != static_cast<uint32_t>((record.rows * record.columns + 7) / 8))
+			{
+				return false;
+			}
+		}
+
+		std::vector<uint8_t> bits;
+		for (uint64_t i = 0; i < header->count; ++i)
+		{
+			auto& record = records[i];
+			auto name = data + record.offset;
+			Entry entry;
+			entry.token = record.token;
+			entry.name.assign(name, name + record.name);
+			entry.generation = record.generation;
+			entry.rule = static_cast<lifegame::Rule>(record.rule);
+			bits.assign(name + record.name, name + record.name + record.length);
+			entry.dish = std::make_unique<lifegame::Dish>(record.rows, record.columns, 0, 0);
+			entry.dish->unpack(bits);
+			entry.dish->topology(static_cast<lifegame::Topology>(record.topology));
+			entries.push_back(std::move(entry));
+		}
+		return true;
+	}
+}
@@ -0,0 +1,110 @@
+#include <server/ComputePool.hpp>
+#include <algorithm>
+#include <assert.h>
+
+namespace server
+{
+	ComputePool::ComputePool(unsigned int workers)
+	{
+		if (workers == 0)
+		{
+			workers = (std::max)(1u, std::thread::hardware_concurrency());
+		}
+		for (unsigned int w = 0; w < workers; ++w)
+		{
+			workers_.push_back(std::make_unique<Worker>());
+		}
+		for (unsigned int w = 0; w < workers; ++w)
+		{
+			threads_.emplace_back(&ComputePool::run, this, w);
+		}
+	}
+
+	ComputePool::~ComputePool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleeping_);
+			stopping_ = true;
+		}
+		wakeup_.notify_all();
+		for (auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+	void ComputePool::submit(Task&& task)
+	{
+		assert(task);
+		auto& worker = *workers_[next_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.tasks.push_back(std::move(task));
+		}
+		pending_.fetch_add(1, std::memory_order_release);
+		{
+			// Taking the lock prevents a worker from missing the notification between its check & its wait.
+			std::lock_guard<std::mutex> lock(sleeping_);
+		}
+		wakeup_.notify_one();
+	}
+
+	unsigned int ComputePool::workers() const
+	{
+		return static_cast<unsigned int>(workers_.size());
+	}
+
+	void ComputePool::run(unsigned int index)
+	{
+		while (true)
+		{
+			Task task;
+			if (pop(index, task) || steal(index, task))
+			{
+				pending_.fetch_sub(1, std::memory_order_relaxed);
+				task();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleeping_);
+			wakeup_.wait(lock, [this]() {
+				return stopping_ || pending_.load(std::memory_order_acquire) > 0;
+			});
+			if (stopping_)
+			{
+				return;
+			}
+		}
+	}
+
+	bool ComputePool::pop(unsigned int index, Task& task)
+	{
+		// A worker computes its own tasks in submission order.
+		auto& worker = *workers_[index];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.tasks.empty())
+		{
+			return false;
+		}
+		task = std::move(worker.tasks.front());
+		worker.tasks.pop_front();
+		return true;
+	}
+
+	bool ComputePool::steal(unsigned int index, Task& task)
+	{
+		// A thief takes the latest task of another worker, the one its owner would compute last.
+		for (size_t offset = 1; offset < workers_.size(); ++offset)
+		{
+			auto& victim = *workers_[(index + offset) % workers_.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.tasks.empty())
+			{
+				task = std::move(victim.tasks.back());
+				victim.tasks.pop_back();
+				return true;
+			}
+		}
+		return false;
+	}
+}
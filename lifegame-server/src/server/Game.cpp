@@ -0,0 +1,859 @@
+#include <server/Game.hpp>
+#include <server/Files.hpp>
+#include <network/event/Connection.hpp>
+#include <network/event/Disconnection.hpp>
+#include <network/event/Exchange.hpp>
+#include <Protocol.hpp>
+#include <algorithm>
+#include <assert.h>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace server
+{
+	/*
+	* @brief The sizes of its sending queue above which a client is throttled, & below which it is no more.
+	*/
+	static const size_t HIGH_WATERMARK = 64 * 1024;
+	static const size_t LOW_WATERMARK = 16 * 1024;
+
+	static lifegame::metrics::Counter generations("dish.generations");
+	static lifegame::metrics::Counter cached("dish.generations.cached");
+	static lifegame::metrics::Histogram liveTime("dish.live.ns");
+	static lifegame::metrics::Histogram deltaSize("dish.delta.bytes");
+	static lifegame::metrics::Histogram encodedSize("dish.delta.encoded.bytes");
+
+	/*
+	* @brief The delay between two reports of the metrics & the generation cache usage.
+	*/
+	static const std::chrono::seconds REPORT_PERIOD(10);
+
+	/*
+	* @brief The delay between two checkpoints, & the delay restored sessions wait for their clients.
+	*/
+	static const std::chrono::seconds CHECKPOINT_PERIOD(5);
+	static const std::chrono::seconds RESUME_DELAY(60);
+
+	/*
+	* @brief Draw a seed from the system random device.
+	*/
+	static uint64_t entropy()
+	{
+		std::random_device device;
+		return (static_cast<uint64_t>(device()) << 32) | device();
+	}
+
+	/*
+	* @brief Check the sizes of the dish a request creates : [request, rows, columns, ...], each in [1, DIMENSION].
+	*/
+	static bool dimensions(const std::vector<uint8_t>& packet)
+	{
+		return packet.size() > 2 && packet[1] > 0 && packet[1] <= lifegame::DIMENSION && packet[2] > 0 && packet[2] <= lifegame::DIMENSION;
+	}
+
+	Game::Game(network::tcp::Server& server, Backpressure::Policy policy, const std::string& checkpoint, const std::string& logs, const std::string& stats, lifegame::Engine engine) :
+		server_(server), policy_(policy), engine_(engine), path_(checkpoint), logs_(logs), seeds_(entropy()), secrets_(entropy()), stats_(stats),
+		reported_(std::chrono::steady_clock::now()), checkpointed_(std::chrono::steady_clock::now())
+	{
+		std::cout << "Compute pool started with workers: " << pool_.workers() << ", engine: " << lifegame::name(engine_) << std::endl;
+		std::error_code error;
+		if (!logs_.empty() && !std::filesystem::create_directories(logs_, error) && error)
+		{
+			std::cerr << "Generation logs directory error: " << logs_ << std::endl;
+			logs_.clear();
+		}
+		if (!path_.empty())
+		{
+			restore();
+		}
+	}
+
+	Game::~Game() = default;
+
+	void Game::process(const std::map<uint64_t, std::unique_ptr<network::event::Event>>& events)
+	{
+		for (auto const& event : events)
+		{
+			uint64_t client = event.first;
+			if (event.second->is<network::event::Connection>())
+			{
+				connect(client);
+			}
+			else if (event.second->is<network::event::Disconnection>())
+			{
+				disconnect(client);
+			}
+			else if (event.second->is<network::event::Exchange>())
+			{
+				auto exchange = event.second->as<network::event::Exchange>();
+				receive(client, exchange->packet());
+			}
+		}
+	}
+
+	void Game::update()
+	{
+		// Sending the generations computed by the pool.
+		Completion completion;
+		while (completions_.pop(completion))
+		{
+			complete(completion);
+		}
+
+		release();
+		tick();
+		report();
+		expire();
+		checkpoint();
+	}
+
+	void Game::connect(uint64_t client)
+	{
+		if (viewers_.find(client) == nullptr)
+		{
+			std::cout << "Dish booked for: " << client << std::endl;
+			Viewer viewer;
+			viewer.backpressure = Backpressure(policy_, HIGH_WATERMARK, LOW_WATERMARK);
+			viewers_.insert(client, std::move(viewer));
+		}
+		else
+		{
+			std::cerr << "Dish already booked for: " << client << std::endl;
+		}
+	}
+
+	void Game::disconnect(uint64_t client)
+	{
+		auto viewer = viewers_.find(client);
+		if (viewer == nullptr)
+		{
+			std::cerr << "No dish to die for: " << client << std::endl;
+			return;
+		}
+		auto id = viewer->session;
+		viewers_.erase(client);
+
+		auto session = sessions_.find(id);
+		if (session == nullptr)
+		{
+			return;
+		}
+		auto& viewers = session->viewers;
+		viewers.erase(std::remove(viewers.begin(), viewers.end(), client), viewers.end());
+		auto& joining = session->joining;
+		joining.erase(std::remove(joining.begin(), joining.end(), client), joining.end());
+		if (viewers.empty() && joining.empty())
+		{
+			std::cout << "Dish dies for: " << client << std::endl;
+			die(id, *session);
+		}
+		else
+		{
+			std::cout << "Shared dish " << session->name << " left by: " << client << std::endl;
+		}
+	}
+
+	void Game::receive(uint64_t client, const std::vector<uint8_t>& packet)
+	{
+		auto viewer = viewers_.find(client);
+		if (viewer == nullptr)
+		{
+			std::cerr << "No dish to live for: " << client << std::endl;
+			return;
+		}
+
+		auto request = packet.empty() ? lifegame::protocol::Request::Step : static_cast<lifegame::protocol::Request>(packet.front());
+		if (request == lifegame::protocol::Request::Create || request == lifegame::protocol::Request::Join || request == lifegame::protocol::Request::Resume)
+		{
+			if (viewer->session != 0)
+			{
+				std::cerr << "Dish already born for: " << client << std::endl;
+			}
+			else if (request == lifegame::protocol::Request::Create)
+			{
+				create(client, *viewer, packet);
+			}
+			else if (request == lifegame::protocol::Request::Join)
+			{
+				join(client, *viewer, packet);
+			}
+			else
+			{
+				resume(client, *viewer, packet);
+			}
+			return;
+		}
+
+		if (request == lifegame::protocol::Request::Stats)
+		{
+			// The server metrics, then the client traffic : no dish needed.
+			std::string text;
+			statistics(text);
+			auto traffic = server_.statistics(client);
+			text += "client.frames.in " + std::to_string(traffic.framesIn) + "\n";
+			text += "client.bytes.in " + std::to_string(traffic.bytesIn) + "\n";
+			text += "client.frames.out " + std::to_string(traffic.framesOut) + "\n";
+			text += "client.bytes.out " + std::to_string(traffic.bytesOut) + "\n";
+			text += "client.queue.bytes " + std::to_string(server_.queueSize(client)) + "\n";
+			std::vector<uint8_t> reply;
+			lifegame::protocol::header(lifegame::protocol::Reply::Stats, 0, reply);
+			reply.insert(reply.end(), text.cbegin(), text.cbegin() + (std::min)(text.size(), static_cast<size_t>(UINT16_MAX) - reply.size()));
+			send(client, reply);
+			return;
+		}
+
+		auto id = viewer->session;
+		auto session = sessions_.find(id);
+		if (session == nullptr)
+		{
+			std::cerr << "No dish born for: " << client << std::endl;
+		}
+		else if (request == lifegame::protocol::Request::Snapshot)
+		{
+			std::cout << "Dish snapshot for: " << client << std::endl;
+			if (session->computing)
+			{
+				viewer->snapshot = true;
+			}
+			else
+			{
+				snapshot(client, *session);
+			}
+		}
+		else if (!session->name.empty())
+		{
+			std::cerr << "Shared dish lives on its own for: " << client << std::endl;
+		}
+		else if (request == lifegame::protocol::Request::Step)
+		{
+			auto stride = packet.size() > 1 ? packet.at(1) : static_cast<uint8_t>(1);
+			if (stride == 0)
+			{
+				std::cerr << "Invalid step of no generation for: " << client << std::endl;
+			}
+			else if (session->computing || paused(*session))
+			{
+				session->steps.push_back(stride);
+			}
+			else
+			{
+				std::cout << "Dish lives for: " << client << std::endl;
+				live(id, *session, stride);
+			}
+		}
+		else if (request == lifegame::protocol::Request::Subscribe)
+		{
+			if (packet.size() != 2 || packet.at(1) == 0)
+			{
+				std::cerr << "Invalid subscription for: " << client << std::endl;
+			}
+			else
+			{
+				std::cout << "Dish subscribed at " << static_cast<int>(packet.at(1)) << " steps per second for: " << client << std::endl;
+				scheduler_.subscribe(id, packet.at(1), TickScheduler::Clock::now());
+			}
+		}
+		else if (request == lifegame::protocol::Request::Unsubscribe)
+		{
+			std::cout << "Dish unsubscribed for: " << client << std::endl;
+			scheduler_.unsubscribe(id);
+		}
+		else if (request == lifegame::protocol::Request::Seek)
+		{
+			if (packet.size() != 5)
+			{
+				std::cerr << "Invalid seek for: " << client << std::endl;
+			}
+			else
+			{
+				session->seek = (static_cast<uint32_t>(packet[1]) << 24) | (static_cast<uint32_t>(packet[2]) << 16) | (static_cast<uint32_t>(packet[3]) << 8) | packet[4];
+				std::cout << "Dish seeks generation " << session->seek << " for: " << client << std::endl;
+				if (session->computing)
+				{
+					session->seeking = true;
+				}
+				else
+				{
+					seek(*session);
+				}
+			}
+		}
+	}
+
+	void Game::create(uint64_t client, Viewer& viewer, const std::vector<uint8_t>& packet)
+	{
+		if (packet.size() < 6 || !dimensions(packet) || packet.at(4) >= lifegame::RULES || packet.at(5) >= lifegame::TOPOLOGIES)
+		{
+			std::cerr << "Invalid dish for: " << client << std::endl;
+			return;
+		}
+		auto rule = static_cast<lifegame::Rule>(packet.at(4));
+		auto topology = static_cast<lifegame::Topology>(packet.at(5));
+		std::cout << "Dish borns by the " << lifegame::name(rule) << " rule on a " << lifegame::name(topology) << " dish for: " << client << std::endl;
+
+		// Clients build their dish from its seed : its cells are sent only on demand.
+		auto seed = seeds_.next();
+		Session session;
+		session.rule = rule;
+		session.dish = std::make_unique<lifegame::Dish>(packet.at(1), packet.at(2), packet.at(3), seed);
+		session.dish->topology(topology);
+		session.fingerprint = Fingerprint::of(*session.dish);
+		do
+		{
+			session.token = secrets_.next();
+		} while (session.token == 0 || tokens_.find(session.token) != tokens_.end());
+		session.viewers.push_back(client);
+		log(session);
+		auto token = session.token;
+		viewer.session = sessions_.insert(std::move(session));
+		tokens_[token] = viewer.session;
+
+		std::vector<uint8_t> reply;
+		lifegame::protocol::header(lifegame::protocol::Reply::Seed, 0, reply);
+		lifegame::protocol::seed(lifegame::Random::VERSION, seed, reply);
+		send(client, reply);
+
+		reply.clear();
+		lifegame::protocol::header(lifegame::protocol::Reply::Session, 0, reply);
+		lifegame::protocol::token(token, reply);
+		send(client, reply);
+	}
+
+	void Game::join(uint64_t client, Viewer& viewer, const std::vector<uint8_t>& packet)
+	{
+		if (packet.size() <= 7 || !dimensions(packet) || packet.at(4) == 0 || packet.at(5) >= lifegame::RULES || packet.at(6) >= lifegame::TOPOLOGIES)
+		{
+			std::cerr << "Invalid shared dish for: " << client << std::endl;
+			return;
+		}
+
+		// The rule & the topology of an existing dish are kept : every viewer watches the same generations.
+		std::string name(packet.cbegin() + 7, packet.cend());
+		uint64_t id;
+		auto named = names_.find(name);
+		if (named == names_.end())
+		{
+			Session session;
+			session.name = name;
+			session.rule = static_cast<lifegame::Rule>(packet.at(5));
+			session.dish = std::make_unique<lifegame::Dish>(packet.at(1), packet.at(2), packet.at(3), seeds_.next());
+			session.dish->topology(static_cast<lifegame::Topology>(packet.at(6)));
+			std::cout << "Shared dish " << name << " borns by the " << lifegame::name(session.rule) << " rule on a " << lifegame::name(session.dish->topology())
+				<< " dish at " << static_cast<int>(packet.at(4)) << " steps per second." << std::endl;
+			session.fingerprint = Fingerprint::of(*session.dish);
+			id = sessions_.insert(std::move(session));
+			names_[name] = id;
+			scheduler_.subscribe(id, packet.at(4), TickScheduler::Clock::now());
+		}
+		else
+		{
+			id = named->second;
+			auto restored = sessions_.find(id);
+			if (restored->viewers.empty() && restored->joining.empty())
+			{
+				// A restored dish lives again with its first viewer.
+				std::cout << "Restored shared dish " << name << " lives at " << static_cast<int>(packet.at(4)) << " steps per second." << std::endl;
+				scheduler_.subscribe(id, packet.at(4), TickScheduler::Clock::now());
+			}
+		}
+
+		std::cout << "Shared dish " << name << " joined by: " << client << std::endl;
+		viewer.session = id;
+
+		// A late joiner starts from the current generation, as soon as it is computed.
+		auto& session = *sessions_.find(id);
+		if (session.computing)
+		{
+			session.joining.push_back(client);
+		}
+		else
+		{
+			snapshot(client, session);
+			session.viewers.push_back(client);
+		}
+	}
+
+	void Game::resume(uint64_t client, Viewer& viewer, const std::vector<uint8_t>& packet)
+	{
+		uint64_t token;
+		if (!dimensions(packet) || !lifegame::protocol::token(packet, 6, token))
+		{
+			std::cerr << "Invalid session token for: " << client << std::endl;
+			return;
+		}
+
+		// A restored dish is resumed by a single client, any other gets a new dish.
+		auto resumed = tokens_.find(token);
+		auto session = resumed == tokens_.end() ? nullptr : sessions_.find(resumed->second);
+		if (session == nullptr || !session->viewers.empty() || !session->joining.empty())
+		{
+			std::cout << "Unknown session token for: " << client << std::endl;
+			create(client, viewer, packet);
+			return;
+		}
+
+		std::cout << "Dish resumed at generation " << session->generation << " for: " << client << std::endl;
+		viewer.session = resumed->second;
+		session->viewers.push_back(client);
+
+		std::vector<uint8_t> reply;
+		lifegame::protocol::header(lifegame::protocol::Reply::Session, 0, reply);
+		lifegame::protocol::token(token, reply);
+		send(client, reply);
+		snapshot(client, *session);
+	}
+
+	void Game::die(uint64_t id, const Session& session)
+	{
+		// A dish being computed dies with its completion.
+		if (!session.name.empty())
+		{
+			names_.erase(session.name);
+		}
+		if (session.token != 0)
+		{
+			tokens_.erase(session.token);
+		}
+		scheduler_.unsubscribe(id);
+		sessions_.erase(id);
+	}
+
+	void Game::live(uint64_t id, Session& session, uint8_t stride)
+	{
+		// Let the pool advance a dish by one step of several generations, the result is queued as a completion.
+		assert(!session.computing && session.dish != nullptr);
+		session.computing = true;
+		auto completion = std::make_shared<Completion>();
+		completion->session = id;
+		completion->rule = session.rule;
+		completion->dish = std::move(session.dish);
+		completion->fingerprint = session.fingerprint;
+		completion->log = std::move(session.log);
+		auto generation = session.generation += stride;
+		lifegame::protocol::header(lifegame::protocol::Reply::Delta, generation, completion->reply);
+		pool_.submit([completion, generation, stride, this]() {
+			// Identical dishes have the same next generations : they are computed once, then applied as a delta.
+			auto& dish = *completion->dish;
+			auto& reply = completion->reply;
+			GenerationCache::Key key{ completion->fingerprint, dish.rows(), dish.columns(), lifegame::code(completion->rule), dish.topology(), stride };
+			std::vector<uint8_t> cells;
+			if (cache_.find(key, cells))
+			{
+				dish.modify(cells);
+				reply.insert(reply.end(), cells.cbegin(), cells.cend());
+				cached.add();
+			}
+			else
+			{
+				auto start = std::chrono::steady_clock::now();
+				// Several generations at once are lived band after band, out of the memory of a single one.
+				auto engine = stride > 1 ? lifegame::Engine::Tiles : engine_;
+				dish.live(reply, completion->rule, engine, stride);
+				liveTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+				cache_.insert(key, std::vector<uint8_t>(reply.cbegin() + lifegame::protocol::REPLY_HEADER_SIZE, reply.cend()));
+			}
+			generations.add(stride);
+			deltaSize.record(reply.size() - lifegame::protocol::REPLY_HEADER_SIZE);
+			completion->fingerprint.update(reply, lifegame::protocol::REPLY_HEADER_SIZE);
+			if (completion->log != nullptr)
+			{
+				completion->log->append(generation, stride, reply, lifegame::protocol::REPLY_HEADER_SIZE, dish);
+			}
+			// Encoded once for all the viewers : the cache, the fingerprint, the log & the held back deltas keep the triples.
+			lifegame::protocol::delta(dish, reply, completion->encoded);
+			encodedSize.record(completion->encoded.size() - lifegame::protocol::REPLY_HEADER_SIZE);
+			completions_.push(std::move(*completion));
+		});
+	}
+
+	void Game::complete(Completion& completion)
+	{
+		auto session = sessions_.find(completion.session);
+		if (session == nullptr)
+		{
+			checkpoint(completion.session, nullptr);
+			return;
+		}
+		session->computing = false;
+		session->dish = std::move(completion.dish);
+		session->fingerprint = completion.fingerprint;
+		session->log = std::move(completion.log);
+		checkpoint(completion.session, session);
+
+		// Sending next step to viewers, even an empty one : the client may count on it.
+		auto& reply = completion.reply;
+		if (reply.size() == lifegame::protocol::REPLY_HEADER_SIZE)
+		{
+			std::cout << "Dish sleeps for: " << completion.session << std::endl;
+		}
+		for (auto client : session->viewers)
+		{
+			auto viewer = viewers_.find(client);
+			if (viewer != nullptr)
+			{
+				deliver(client, *viewer, *session, completion);
+			}
+		}
+
+		for (auto client : session->joining)
+		{
+			snapshot(client, *session);
+			session->viewers.push_back(client);
+		}
+		session->joining.clear();
+	}
+
+	void Game::deliver(uint64_t client, Viewer& viewer, const Session& session, const Completion& completion)
+	{
+		// A shared dish never pauses for one of its viewers.
+		auto& backpressure = viewer.backpressure;
+		auto coalesce = backpressure.policy() == Backpressure::Policy::Coalesce || !session.name.empty();
+		if (coalesce && (backpressure.throttle(server_.queueSize(client)) || backpressure.backlogged()))
+		{
+			// Holding the delta back, until the client catches up.
+			backpressure.merge(completion.reply);
+		}
+		else
+		{
+			send(client, completion.encoded);
+		}
+	}
+
+	void Game::snapshot(uint64_t client, const Session& session)
+	{
+		// A snapshot supersedes the deltas held back for the client.
+		auto viewer = viewers_.find(client);
+		if (viewer != nullptr)
+		{
+			viewer->backpressure.clear();
+		}
+
+		std::vector<uint8_t> reply;
+		lifegame::protocol::header(lifegame::protocol::Reply::Snapshot, session.generation, reply);
+		lifegame::protocol::snapshot(*session.dish, reply);
+		send(client, reply);
+	}
+
+	void Game::seek(Session& session)
+	{
+		// The seeked generation replaces the dish, & the dish lives on from it.
+		session.seeking = false;
+		auto dish = session.log == nullptr ? nullptr : session.log->seek(session.seek);
+		if (dish == nullptr)
+		{
+			std::cerr << "Generation not logged: " << session.seek << std::endl;
+			return;
+		}
+		dish->topology(session.dish->topology());
+		session.dish = std::move(dish);
+		session.generation = session.seek;
+		session.fingerprint = Fingerprint::of(*session.dish);
+		for (auto client : session.viewers)
+		{
+			snapshot(client, session);
+		}
+	}
+
+	void Game::log(Session& session)
+	{
+		if (logs_.empty() || session.token == 0)
+		{
+			return;
+		}
+		std::ostringstream path;
+		path << logs_ << "/" << std::hex << std::setw(16) << std::setfill('0') << session.token << ".log";
+		session.log = std::make_unique<GenerationLog>(path.str());
+		if (!session.log->open())
+		{
+			std::cerr << "Generation log opening error: " << path.str() << std::endl;
+			session.log.reset();
+			return;
+		}
+		session.log->append(session.generation, 0, {}, 0, *session.dish);
+	}
+
+	void Game::send(uint64_t client, const std::vector<uint8_t>& packet)
+	{
+		if (!server_.send(client, packet.data(), static_cast<unsigned int>(packet.size())))
+		{
+			std::cerr << "Server sending error: " << network::error::latest() << std::endl;
+		}
+	}
+
+	bool Game::paused(const Session& session)
+	{
+		if (!session.name.empty() || session.viewers.empty())
+		{
+			return false;
+		}
+		auto viewer = viewers_.find(session.viewers.front());
+		return viewer != nullptr && viewer->backpressure.policy() == Backpressure::Policy::Pause && viewer->backpressure.throttled();
+	}
+
+	void Game::release()
+	{
+		// Releasing throttled clients which caught up, with their held delta & their pending snapshot.
+		for (size_t v = 0; v < viewers_.size(); ++v)
+		{
+			auto client = viewers_.key(v);
+			auto& viewer = viewers_.value(v);
+			auto& backpressure = viewer.backpressure;
+			if (!backpressure.throttle(server_.queueSize(client)) && backpressure.backlogged())
+			{
+				// Encoded as the live deltas, from the sizes of the dish : once the dish is back from the pool.
+				auto session = sessions_.find(viewer.session);
+				if (session == nullptr)
+				{
+					backpressure.clear();
+				}
+				else if (!session->computing)
+				{
+					std::vector<uint8_t> delta;
+					backpressure.flush(delta);
+					std::vector<uint8_t> reply;
+					lifegame::protocol::delta(*session->dish, delta, reply);
+					send(client, reply);
+				}
+			}
+
+			if (viewer.snapshot)
+			{
+				auto session = sessions_.find(viewer.session);
+				if (session != nullptr && !session->computing)
+				{
+					viewer.snapshot = false;
+					snapshot(client, *session);
+				}
+			}
+		}
+
+		// Resuming the seeks & the steps asked for while computing or paused.
+		for (size_t s = 0; s < sessions_.size(); ++s)
+		{
+			auto& session = sessions_.value(s);
+			if (session.seeking && !session.computing)
+			{
+				seek(session);
+			}
+			if (!session.steps.empty() && !session.computing && session.dish != nullptr && !paused(session))
+			{
+				auto generations = session.steps.front();
+				session.steps.pop_front();
+				live(sessions_.key(s), session, generations);
+			}
+		}
+	}
+
+	void Game::tick()
+	{
+		// Letting subscribed dishes live, unless their previous step is still being computed or they are paused.
+		ticks_.clear();
+		scheduler_.due(TickScheduler::Clock::now(), ticks_);
+		for (auto id : ticks_)
+		{
+			auto session = sessions_.find(id);
+			if (session != nullptr && !session->computing && session->dish != nullptr && !paused(*session))
+			{
+				live(id, *session);
+			}
+		}
+	}
+
+	void Game::report()
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (now - reported_ < REPORT_PERIOD)
+		{
+			return;
+		}
+		auto elapsed = std::chrono::duration<double>(now - reported_).count();
+		reported_ = now;
+
+		auto statistics = cache_.statistics();
+		if (statistics.hits + statistics.misses > 0)
+		{
+			std::cout << "Generation cache hit rate: " << static_cast<int>(statistics.hitRate() * 100) << "%, entries: " << statistics.entries << ", memory: " << statistics.memory / 1024 << " KiB" << std::endl;
+		}
+		if (stats_.empty())
+		{
+			return;
+		}
+
+		// The metrics, their rates since the previous report, then the traffic of each client.
+		std::string text;
+		this->statistics(text);
+		std::vector<lifegame::metrics::CounterValue> counters;
+		std::vector<lifegame::metrics::HistogramValue> histograms;
+		lifegame::metrics::collect(counters, histograms);
+		std::ostringstream stream;
+		for (size_t c = 0; c < counters.size(); ++c)
+		{
+			auto previous = c < counters_.size() ? counters_[c].value : 0;
+			stream << counters[c].name << ".rate " << static_cast<int64_t>((counters[c].value - previous) / elapsed) << "\n";
+		}
+		counters_ = std::move(counters);
+		for (size_t v = 0; v < viewers_.size(); ++v)
+		{
+			auto client = viewers_.key(v);
+			auto traffic = server_.statistics(client);
+			stream << "client " << client << " frames.in=" << traffic.framesIn << " bytes.in=" << traffic.bytesIn << " frames.out=" << traffic.framesOut
+				<< " bytes.out=" << traffic.bytesOut << " queue.bytes=" << server_.queueSize(client) << "\n";
+		}
+		text += stream.str();
+
+		// Written aside, then renamed over the previous report : readers never see a partial or a missing report.
+		auto temporary = stats_ + ".tmp";
+		bool written;
+		{
+			std::ofstream file(temporary, std::ios::trunc);
+			file << text;
+			file.flush();
+			written = static_cast<bool>(file);
+		}
+		if (!written || !replace(temporary, stats_))
+		{
+			std::cerr << "Metrics writing error: " << stats_ << std::endl;
+		}
+	}
+
+	void Game::statistics(std::string& text)
+	{
+		std::vector<lifegame::metrics::CounterValue> counters;
+		std::vector<lifegame::metrics::HistogramValue> histograms;
+		lifegame::metrics::collect(counters, histograms);
+		lifegame::metrics::write(counters, histograms, text);
+
+		auto cache = cache_.statistics();
+		std::ostringstream stream;
+		stream << "cache.hits " << cache.hits << "\ncache.misses " << cache.misses << "\ncache.entries " << cache.entries << "\ncache.bytes " << cache.memory << "\n";
+		stream << "sessions " << sessions_.size() << "\n";
+		text += stream.str();
+	}
+
+	void Game::restore()
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::vector<Checkpoint::Entry> entries;
+		if (!Checkpoint::load(path_, entries))
+		{
+			std::cout << "No checkpoint restored from: " << path_ << std::endl;
+			return;
+		}
+
+		// Restored dishes stay still until resumed by their clients.
+		for (auto& entry : entries)
+		{
+			Session session;
+			session.name = std::move(entry.name);
+			session.token = entry.token;
+			session.generation = entry.generation;
+			session.rule = entry.rule;
+			session.dish = std::move(entry.dish);
+			session.fingerprint = Fingerprint::of(*session.dish);
+			log(session);
+			auto name = session.name;
+			auto token = session.token;
+			auto id = sessions_.insert(std::move(session));
+			if (!name.empty())
+			{
+				names_[name] = id;
+			}
+			if (token != 0)
+			{
+				tokens_[token] = id;
+			}
+		}
+		restoring_ = !entries.empty();
+		expiry_ = std::chrono::steady_clock::now() + RESUME_DELAY;
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		std::cout << "Dishes restored: " << entries.size() << " in " << elapsed.count() << " us" << std::endl;
+	}
+
+	void Game::expire()
+	{
+		if (!restoring_ || std::chrono::steady_clock::now() < expiry_)
+		{
+			return;
+		}
+		restoring_ = false;
+
+		// Letting the restored dishes nobody came back for die.
+		size_t expired = 0;
+		for (size_t s = sessions_.size(); s-- > 0;)
+		{
+			auto& session = sessions_.value(s);
+			if (session.viewers.empty() && session.joining.empty() && !session.computing)
+			{
+				die(sessions_.key(s), session);
+				++expired;
+			}
+		}
+		std::cout << "Restored dishes expired: " << expired << std::endl;
+	}
+
+	void Game::checkpoint()
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (path_.empty() || checkpoint_ != nullptr || saving_ || now - checkpointed_ < CHECKPOINT_PERIOD)
+		{
+			return;
+		}
+		checkpointed_ = now;
+
+		// Dishes being computed are added as soon as they are back.
+		checkpoint_ = std::make_unique<Checkpoint>();
+		for (size_t s = 0; s < sessions_.size(); ++s)
+		{
+			auto& session = sessions_.value(s);
+			if (session.computing)
+			{
+				pending_.push_back(sessions_.key(s));
+			}
+			else
+			{
+				checkpoint_->add(session.token, session.name, session.generation, session.rule, *session.dish);
+			}
+		}
+		if (pending_.empty())
+		{
+			save();
+		}
+	}
+
+	void Game::checkpoint(uint64_t id, const Session* session)
+	{
+		auto pending = std::find(pending_.begin(), pending_.end(), id);
+		if (checkpoint_ == nullptr || pending == pending_.end())
+		{
+			return;
+		}
+		pending_.erase(pending);
+		if (session != nullptr)
+		{
+			checkpoint_->add(session->token, session->name, session->generation, session->rule, *session->dish);
+		}
+		if (pending_.empty())
+		{
+			save();
+		}
+	}
+
+	void Game::save()
+	{
+		// Written by the pool, away from the network thread.
+		saving_ = true;
+		std::shared_ptr<Checkpoint> checkpoint = std::move(checkpoint_);
+		pool_.submit([checkpoint, this]() {
+			if (!checkpoint->save(path_))
+			{
+				std::cerr << "Checkpoint saving error: " << path_ << std::endl;
+			}
+			saving_ = false;
+		});
+	}
+}
@@ -0,0 +1,112 @@
+#include <server/GenerationCache.hpp>
+#include <assert.h>
+
+namespace server
+{
+	/*
+	* @brief Mix 64 bits (SplitMix64 finalizer).
+	*/
+	static inline uint64_t mix(uint64_t z)
+	{
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	Fingerprint Fingerprint::of(const lifegame::Dish& dish)
+	{
+		Fingerprint fingerprint;
+		for (auto r = 1; r < dish.rows() - 1; ++r)
+		{
+			for (auto c = 1; c < dish.columns() - 1; ++c)
+			{
+				if (dish.alive(r, c))
+				{
+					fingerprint.toggle(r, c);
+				}
+			}
+		}
+		return fingerprint;
+	}
+
+	void Fingerprint::update(const std::vector<uint8_t>& cells, size_t offset)
+	{
+		// A cell only appears in a delta when its state changes.
+		assert((cells.size() - offset) % 3 == 0);
+		for (size_t i = offset; i + 2 < cells.size(); i = i + 3)
+		{
+			toggle(cells[i], cells[i + 1]);
+		}
+	}
+
+	void Fingerprint::toggle(const uint8_t row, const uint8_t column)
+	{
+		// The keys are derived from the coordinates, rather than read from a table.
+		uint64_t cell = (static_cast<uint64_t>(row) << 8) | column;
+		high ^= mix(cell * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull);
+		low ^= mix(cell * 0xD1B54A32D192ED03ull + 0x8CB92BA72F3D8DD7ull);
+	}
+
+	double GenerationCache::Statistics::hitRate() const
+	{
+		auto lookups = hits + misses;
+		return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+	}
+
+	size_t GenerationCache::Hash::operator()(const Key& key) const
+	{
+		return static_cast<size_t>(key.fingerprint.low ^ (static_cast<uint64_t>(key.rows) << 40) ^ (static_cast<uint64_t>(key.columns) << 48) ^ (static_cast<uint64_t>(key.topology) << 56) ^ (static_cast<uint64_t>(key.generations) << 32) ^ key.rule);
+	}
+
+	GenerationCache::GenerationCache(size_t capacity) : capacity_(capacity)
+	{
+	}
+
+	bool GenerationCache::find(const Key& key, std::vector<uint8_t>& cells)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto iterator = index_.find(key);
+		if (iterator == index_.end())
+		{
+			++statistics_.misses;
+			return false;
+		}
+		++statistics_.hits;
+		entries_.splice(entries_.begin(), entries_, iterator->second);
+		cells = iterator->second->cells;
+		return true;
+	}
+
+	void GenerationCache::insert(const Key& key, std::vector<uint8_t>&& cells)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (index_.find(key) != index_.end())
+		{
+			return; // Computed concurrently by another worker.
+		}
+
+		entries_.push_front(Entry{ key, std::move(cells) });
+		index_[key] = entries_.begin();
+		statistics_.memory += footprint(entries_.front());
+		while (statistics_.memory > capacity_ && entries_.size() > 1)
+		{
+			auto& evicted = entries_.back();
+			statistics_.memory -= footprint(evicted);
+			index_.erase(evicted.key);
+			entries_.pop_back();
+		}
+		statistics_.entries = entries_.size();
+	}
+
+	GenerationCache::Statistics GenerationCache::statistics() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return statistics_;
+	}
+
+	size_t GenerationCache::footprint(const Entry& entry)
+	{
+		// The cells, the list node & the index node (roughly).
+		return entry.cells.capacity() + sizeof(Entry) + 2 * sizeof(void*) + sizeof(Key) + 4 * sizeof(void*);
+	}
+}
@@ -0,0 +1,270 @@
+#include <server/GenerationLog.hpp>
+#include <algorithm>
+#include <assert.h>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace server
+{
+	static const size_t RECORD_HEADER_SIZE = 1 + sizeof(uint32_t) + sizeof(uint32_t);
+	static const size_t INDEX_ENTRY_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+	static const uint32_t MAXIMUM_LENGTH = 1024 * 1024; // above the largest dish, in any record.
+
+	static void write(const uint64_t value, const size_t size, std::vector<uint8_t>& bytes)
+	{
+		for (size_t shift = size * 8; shift > 0; shift -= 8)
+		{
+			bytes.push_back(static_cast<uint8_t>(value >> (shift - 8)));
+		}
+	}
+
+	static uint64_t read(const uint8_t* bytes, const size_t size)
+	{
+		uint64_t value = 0;
+		for (size_t i = 0; i < size; ++i)
+		{
+			value = (value << 8) | bytes[i];
+		}
+		return value;
+	}
+
+	/*
+	* @brief Read the next record of a log file.
+	*
+	* @return whether (or not) a complete record has been read.
+	*/
+	static bool read(std::istream& file, uint8_t& type, uint32_t& generation, std::vector<uint8_t>& payload)
+	{
+		uint8_t header[RECORD_HEADER_SIZE];
+		if (!file.read(reinterpret_cast<char*>(header), sizeof(header)))
+		{
+			return false;
+		}
+		type = header[0];
+		generation = static_cast<uint32_t>(read(header + 1, sizeof(uint32_t)));
+		auto length = static_cast<uint32_t>(read(header + 1 + sizeof(uint32_t), sizeof(uint32_t)));
+		if (length > MAXIMUM_LENGTH)
+		{
+			return false;
+		}
+		payload.resize(length);
+		return length == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(payload.data()), length));
+	}
+
+	/*
+	* @brief Build a dish from the payload of a keyframe.
+	*/
+	static std::unique_ptr<lifegame::Dish> keyframe(const std::vector<uint8_t>& payload)
+	{
+		if (payload.size() < 2 || payload[0] == 0 || payload[0] > lifegame::DIMENSION || payload[1] == 0 || payload[1] > lifegame::DIMENSION)
+		{
+			return nullptr;
+		}
+		std::vector<uint8_t> bits(payload.cbegin() + 2, payload.cend());
+		if (bits.size() != static_cast<size_t>((payload[0] * payload[1] + 7) / 8))
+		{
+			return nullptr;
+		}
+		auto dish = std::make_unique<lifegame::Dish>(payload[0], payload[1], 0, 0);
+		dish->unpack(bits);
+		return dish;
+	}
+
+	GenerationLog::GenerationLog(const std::string& path, const uint32_t interval) : path_(path), interval_((std::max)(interval, 1u))
+	{
+	}
+
+	GenerationLog::~GenerationLog()
+	{
+		flush();
+	}
+
+	bool GenerationLog::open()
+	{
+		keyframes_.clear();
+		records_.clear();
+		index_.clear();
+		size_ = 0;
+		latest_ = 0;
+		deltas_ = 0;
+		failed_ = false;
+
+		std::ifstream index(path_ + ".idx", std::ios::binary);
+		uint8_t entry[INDEX_ENTRY_SIZE];
+		while (index.read(reinterpret_cast<char*>(entry), sizeof(entry)))
+		{
+			keyframes_.push_back({ static_cast<uint32_t>(read(entry, sizeof(uint32_t))), read(entry + sizeof(uint32_t), sizeof(uint64_t)) });
+		}
+
+		std::error_code error;
+		auto size = std::filesystem::exists(path_, error) ? static_cast<uint64_t>(std::filesystem::file_size(path_, error)) : 0;
+		if (error)
+		{
+			failed_ = true;
+			return false;
+		}
+
+		// Finding the end of the latest complete generation, from the latest keyframe written.
+		auto indexed = keyframes_.size();
+		uint64_t end = 0;
+		while (!keyframes_.empty())
+		{
+			auto& latest = keyframes_.back();
+			std::ifstream file(path_, std::ios::binary);
+			file.seekg(static_cast<std::streamoff>(latest.offset));
+			uint8_t type;
+			uint32_t generation;
+			std::vector<uint8_t> payload;
+			if (latest.offset < size && read(file, type, generation, payload) && type == static_cast<uint8_t>(Record::Keyframe) && generation == latest.generation)
+			{
+				end = static_cast<uint64_t>(file.tellg());
+				latest_ = generation;
+				while (read(file, type, generation, payload) && type == static_cast<uint8_t>(Record::Delta) && generation > latest_)
+				{
+					end = static_cast<uint64_t>(file.tellg());
+					latest_ = generation;
+					++deltas_;
+				}
+				break;
+			}
+			keyframes_.pop_back();
+		}
+
+		if (end != size)
+		{
+			std::cout << "Generation log truncated to generation " << latest_ << ": " << path_ << std::endl;
+			std::filesystem::resize_file(path_, end, error);
+		}
+		if (keyframes_.size() != indexed)
+		{
+			std::ofstream file(path_ + ".idx", std::ios::binary | std::ios::trunc);
+			std::vector<uint8_t> bytes;
+			for (auto const& keyframe : keyframes_)
+			{
+				write(keyframe.generation, sizeof(uint32_t), bytes);
+				write(keyframe.offset, sizeof(uint64_t), bytes);
+			}
+			file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+			failed_ = !file;
+		}
+		failed_ = failed_ || static_cast<bool>(error);
+		size_ = end;
+		return !failed_;
+	}
+
+	void GenerationLog::append(const uint32_t generation, const uint32_t stride, const std::vector<uint8_t>& cells, const size_t offset, const lifegame::Dish& dish)
+	{
+		if (failed_ || (!keyframes_.empty() && generation <= latest_))
+		{
+			return;
+		}
+
+		// A delta only chains from the latest logged generation, whatever the number of generations lived in between.
+		if (keyframes_.empty() || stride == 0 || generation - stride != latest_ || deltas_ + 1 >= interval_)
+		{
+			std::vector<uint8_t> payload;
+			payload.push_back(dish.rows() - 2);
+			payload.push_back(dish.columns() - 2);
+			dish.pack(payload);
+			record(Record::Keyframe, generation, payload, 0);
+			latest_ = generation;
+			deltas_ = 0;
+			flush();
+		}
+		else
+		{
+			assert((cells.size() - offset) % 3 == 0);
+			record(Record::Delta, generation, cells, offset);
+			latest_ = generation;
+			++deltas_;
+		}
+	}
+
+	bool GenerationLog::flush()
+	{
+		if (failed_ || records_.empty())
+		{
+			return !failed_;
+		}
+
+		// Records first : the index never refers to a missing record.
+		{
+			std::ofstream file(path_, std::ios::binary | std::ios::app);
+			file.write(reinterpret_cast<const char*>(records_.data()), records_.size());
+			failed_ = !file;
+		}
+		if (!failed_ && !index_.empty())
+		{
+			std::ofstream file(path_ + ".idx", std::ios::binary | std::ios::app);
+			file.write(reinterpret_cast<const char*>(index_.data()), index_.size());
+			failed_ = !file;
+		}
+		if (failed_)
+		{
+			std::cerr << "Generation log writing error: " << path_ << std::endl;
+			return false;
+		}
+		size_ += records_.size();
+		records_.clear();
+		index_.clear();
+		return true;
+	}
+
+	std::unique_ptr<lifegame::Dish> GenerationLog::seek(const uint32_t generation)
+	{
+		if (!flush() || keyframes_.empty() || generation > latest_ || generation < keyframes_.front().generation)
+		{
+			return nullptr;
+		}
+
+		// Reading the closest keyframe, then the deltas up to the generation.
+		auto closest = std::upper_bound(keyframes_.cbegin(), keyframes_.cend(), generation, [](uint32_t value, const Keyframe& keyframe) {
+			return value < keyframe.generation;
+		}) - 1;
+		std::ifstream file(path_, std::ios::binary);
+		file.seekg(static_cast<std::streamoff>(closest->offset));
+		uint8_t type;
+		uint32_t current;
+		std::vector<uint8_t> payload;
+		if (!read(file, type, current, payload) || type != static_cast<uint8_t>(Record::Keyframe) || current != closest->generation)
+		{
+			return nullptr;
+		}
+		auto dish = keyframe(payload);
+		while (dish != nullptr && current < generation)
+		{
+			if (!read(file, type, current, payload) || type != static_cast<uint8_t>(Record::Delta) || payload.size() % 3 != 0)
+			{
+				return nullptr;
+			}
+			dish->modify(payload);
+		}
+		return current == generation ? std::move(dish) : nullptr;
+	}
+
+	bool GenerationLog::empty() const
+	{
+		return keyframes_.empty();
+	}
+
+	uint32_t GenerationLog::latest() const
+	{
+		return latest_;
+	}
+
+	void GenerationLog::record(const Record type, const uint32_t generation, const std::vector<uint8_t>& payload, const size_t offset)
+	{
+		if (type == Record::Keyframe)
+		{
+			Keyframe keyframe = { generation, size_ + records_.size() };
+			keyframes_.push_back(keyframe);
+			write(keyframe.generation, sizeof(uint32_t), index_);
+			write(keyframe.offset, sizeof(uint64_t), index_);
+		}
+		records_.push_back(static_cast<uint8_t>(type));
+		write(generation, sizeof(uint32_t), records_);
+		write(payload.size() - offset, sizeof(uint32_t), records_);
+		records_.insert(records_.end(), payload.cbegin() + offset, payload.cend());
+	}
+}
@@ -3,6 +3,9 @@
 #include <network/event/Connection.hpp>
 #include <network/event/Disconnection.hpp>
 #include <network/event/Exchange.hpp>
+#include <server/SlotMap.hpp>
+#include <Metrics.hpp>
+#include <Trace.hpp>
 #include <map>
 #include <list>
 #include <assert.h>
@@ -11,6 +14,8 @@ namespace network
 {
 	namespace tcp
 	{
+		static lifegame::metrics::Counter connected("network.clients");
+		static lifegame::metrics::Counter accepted("network.accepted");
 
 		/////////////////////////////////////////////////////////////////////////////////////
 
@@ -26,12 +31,15 @@ namespace network
 
 			bool startup(unsigned short port);
 			void shutdown();
+			void disconnect(uint64_t clientid);
 			void process(std::map<uint64_t, std::unique_ptr<event::Event>>& events);
 			bool send(uint64_t clientid, const PacketUnit* packet, unsigned int length);
 			bool send(const PacketUnit* packet, unsigned int length);
+			size_t queueSize(uint64_t clientid) const;
+			Statistics statistics(uint64_t clientid) const;
 
 		private:
-			std::map<uint64_t, Client> clients_;
+			::server::SlotMap<Client> clients_; // clients by id : ids are never reused, unlike sockets.
 			SOCKET socket_ = INVALID_SOCKET;
 
 		};
@@ -83,10 +91,11 @@ namespace network
 
 		void Server::ServerImpl::shutdown()
 		{
-			for (auto& client : clients_)
+			for (size_t c = 0; c < clients_.size(); ++c)
 			{
-				client.second.disconnect();
+				clients_.value(c).disconnect();
 			}
+			connected.add(-static_cast<int64_t>(clients_.size()));
 			clients_.clear();
 			if (socket_ != INVALID_SOCKET)
 			{
@@ -97,37 +106,39 @@ namespace network
 
 		void Server::ServerImpl::process(std::map<uint64_t, std::unique_ptr<event::Event>>& events)
 		{
+			LIFEGAME_TRACE("Server::process");
 			if (socket_ == INVALID_SOCKET)
 			{
 				return;
 			}
 
 			// Processing message reception & send for each client. 
-			for (auto itClient = clients_.begin(); itClient != clients_.end(); )
+			for (size_t c = 0; c < clients_.size(); )
 			{
-				auto& client = *itClient;
-				auto event = client.second.process();
+				auto event = clients_.value(c).process();
 				if (event)
 				{
-					auto id = client.first;
+					auto id = clients_.key(c);
 					if (event->is<event::Disconnection>())
 					{
-						itClient = clients_.erase(itClient);
+						clients_.erase(id); // The last client takes its place.
+						connected.add(-1);
 					}
 					else
 					{
-						++itClient;
+						++c;
 					}
 					events[id] = std::move(event);
 				}
 				else
 				{
-					++itClient;
+					++c;
 				}
 			}
 
 			// Listening to new clients.
 			/// TODO use in another thread instead -> can block when new clients don't stop coming.
+			LIFEGAME_TRACE("Server::accept");
 			while (true)
 			{
 				sockaddr_in addr = { 0 };
@@ -140,31 +151,55 @@ namespace network
 				Client client;
 				if (client.initialize(std::move(clientSocket)))
 				{
-					auto id = client.id();
+					auto id = clients_.insert(std::move(client));
+					connected.add();
+					accepted.add();
 					auto connection = std::make_unique<event::Connection>(event::Connection::State::Successfull);
 					events[id] = std::move(connection);
-					clients_[id] = std::move(client);
 				}
 			}
 
 		}
 
+		void Server::ServerImpl::disconnect(uint64_t clientid)
+		{
+			auto client = clients_.find(clientid);
+			if (client != nullptr)
+			{
+				client->disconnect();
+				clients_.erase(clientid);
+				connected.add(-1);
+			}
+		}
+
 		bool Server::ServerImpl::send(uint64_t clientid, const PacketUnit* packet, unsigned int length)
 		{
-			auto itClient = clients_.find(clientid);
-			return itClient != clients_.end() && itClient->second.send(packet, length);
+			auto client = clients_.find(clientid);
+			return client != nullptr && client->send(packet, length);
 		}
 
 		bool Server::ServerImpl::send(const PacketUnit* packet, unsigned int length)
 		{
 			bool sent = true;
-			for (auto& client : clients_)
+			for (size_t c = 0; c < clients_.size(); ++c)
 			{
-				sent &= client.second.send(packet, length);
+				sent &= clients_.value(c).send(packet, length);
 			}
 			return sent;
 		}
 
+		size_t Server::ServerImpl::queueSize(uint64_t clientid) const
+		{
+			auto client = clients_.find(clientid);
+			return client != nullptr ? client->queueSize() : 0;
+		}
+
+		Statistics Server::ServerImpl::statistics(uint64_t clientid) const
+		{
+			auto client = clients_.find(clientid);
+			return client != nullptr ? client->statistics() : Statistics();
+		}
+
 		/////////////////////////////////////////////////////////////////////////////////////
 
 		Server::Server() = default;
@@ -198,6 +233,14 @@ namespace network
 			}
 		}
 
+		void Server::disconnect(uint64_t clientid)
+		{
+			if (impl_)
+			{
+				impl_->disconnect(clientid);
+			}
+		}
+
 		void Server::process(std::map<uint64_t, std::unique_ptr<event::Event>>& events)
 		{
 			if (impl_)
@@ -215,5 +258,15 @@ namespace network
 		{
 			return impl_ ? impl_->send(packet, length) : false;
 		}
+
+		size_t Server::queueSize(uint64_t clientid) const
+		{
+			return impl_ ? impl_->queueSize(clientid) : 0;
+		}
+
+		Statistics Server::statistics(uint64_t clientid) const
+		{
+			return impl_ ? impl_->statistics(clientid) : Statistics();
+		}
 	}
-}
\ No newline at end of file
+}
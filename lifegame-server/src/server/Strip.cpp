@@ -0,0 +1,285 @@
+#include <server/Strip.hpp>
+#include <network/event/Connection.hpp>
+#include <network/event/Disconnection.hpp>
+#include <network/event/Exchange.hpp>
+#include <Metrics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace server
+{
+	static lifegame::metrics::Histogram innerTime("strip.inner.ns");
+	static lifegame::metrics::Histogram haloWait("strip.halo.wait.ns");
+	static lifegame::metrics::Histogram generationTime("strip.generation.ns");
+
+	/*
+	* @brief The delay between two connections to the strip below, while it starts up.
+	*/
+	static const std::chrono::milliseconds RETRY_DELAY(100);
+
+	/*
+	* @brief Mix the index of a strip into the seed of the dish : neighbour strips draw unrelated cells.
+	*/
+	static uint64_t mix(uint64_t seed, unsigned int index)
+	{
+		return seed ^ (static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ull);
+	}
+
+	Strip::Strip(const Layout& layout, uint8_t rows, uint8_t columns, uint8_t ratio, uint64_t seed, lifegame::Rule rule, lifegame::Topology topology) :
+		layout_(layout), rule_(rule), dish_(rows, columns, ratio, mix(seed, layout.index))
+	{
+		// The columns of a torus wrap within the strip, its rows wrap through the chain of strips.
+		dish_.topology(topology);
+		changes_.resize(pool_.workers() + 1);
+	}
+
+	Strip::~Strip()
+	{
+		shutdown();
+	}
+
+	bool Strip::startup()
+	{
+		if (above() && !server_.startup(static_cast<unsigned short>(layout_.port + layout_.index)))
+		{
+			return false;
+		}
+		auto lower = (layout_.index + 1) % layout_.count;
+		while ((above() && !accepted_) || (below() && !connected_))
+		{
+			// The strip below may not be listening yet : the connection is tried again, meanwhile the strip above is accepted.
+			bool connecting = below() && !connected_ && client_.connect(layout_.address, static_cast<unsigned short>(layout_.port + lower));
+			while (connecting)
+			{
+				auto const& event = client_.process();
+				if (event && event->is<network::event::Connection>())
+				{
+					connecting = false;
+					connected_ = event->as<network::event::Connection>()->state() == network::event::Connection::State::Successfull;
+					if (connected_)
+					{
+						std::cout << "Strip connected to the strip below: " << lower << std::endl;
+					}
+				}
+				receive();
+			}
+			if (below() && !connected_)
+			{
+				client_.disconnect();
+				std::this_thread::sleep_for(RETRY_DELAY);
+			}
+			receive();
+		}
+		return true;
+	}
+
+	void Strip::shutdown()
+	{
+		// The last rows may still be queued : the neighbours wait for them.
+		while ((connected_ && client_.queueSize() > 0) || (accepted_ && server_.queueSize(upper_) > 0))
+		{
+			receive();
+		}
+		if (connected_)
+		{
+			client_.disconnect();
+			connected_ = false;
+		}
+		if (accepted_)
+		{
+			server_.shutdown();
+			accepted_ = false;
+		}
+	}
+
+	bool Strip::live()
+	{
+		auto start = std::chrono::steady_clock::now();
+		const uint8_t last = dish_.rows() - 2;
+
+		// The edge rows first : the neighbours compute their own inner rows while these are on their way.
+		if (above())
+		{
+			send(1, true);
+		}
+		if (below())
+		{
+			send(last, false);
+		}
+
+		// The inner rows don't read the halo : they are computed by the pool, while the halo is received.
+		for (auto& changes : changes_)
+		{
+			changes.clear();
+		}
+		const int inner = (std::max)(last - 2, 0);
+		const int tasks = (std::min)(static_cast<int>(pool_.workers()), inner);
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			pending_ = tasks;
+		}
+		for (int t = 0; t < tasks; ++t)
+		{
+			auto first = static_cast<uint8_t>(2 + inner * t / tasks);
+			auto end = static_cast<uint8_t>(2 + inner * (t + 1) / tasks);
+			pool_.submit([this, t, first, end]() {
+				auto begin = std::chrono::steady_clock::now();
+				dish_.next(changes_[t], rule_, first, end);
+				innerTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (--pending_ == 0)
+				{
+					done_.notify_one();
+				}
+			});
+		}
+
+		// The halo : the border rows are out of the inner rows' reach, they are set while the pool computes.
+		auto waiting = std::chrono::steady_clock::now();
+		while ((above() && uppers_.count(generation_) == 0) || (below() && lowers_.count(generation_) == 0))
+		{
+			// A neighbour disconnects once done : only a missing row is an error.
+			receive();
+			if (failed_ || (above() && !accepted_ && uppers_.count(generation_) == 0) || (below() && !connected_ && lowers_.count(generation_) == 0))
+			{
+				std::cerr << "Strip " << (failed_ ? "failed" : "disconnected from a neighbour") << " at generation: " << generation_ << std::endl;
+				std::unique_lock<std::mutex> lock(mutex_);
+				done_.wait(lock, [this]() { return pending_ == 0; });
+				return false;
+			}
+			// The pool & the neighbours may share the processor.
+			std::this_thread::yield();
+		}
+		haloWait.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waiting).count());
+		if (above())
+		{
+			dish_.unpack(0, uppers_[generation_], 0);
+			uppers_.erase(generation_);
+		}
+		if (below())
+		{
+			dish_.unpack(last + 1, lowers_[generation_], 0);
+			lowers_.erase(generation_);
+		}
+		if (layout_.count == 1 && dish_.topology() == lifegame::Topology::Torus)
+		{
+			// A single strip is its own neighbour.
+			std::vector<uint8_t> bits;
+			dish_.pack(last, bits);
+			dish_.pack(1, bits);
+			dish_.unpack(0, bits, 0);
+			dish_.unpack(last + 1, bits, bits.size() / 2);
+		}
+
+		// The edge rows, once the halo is set & the inner rows are computed : then every cell lives from the same generation.
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			done_.wait(lock, [this]() { return pending_ == 0; });
+		}
+		auto& edges = changes_.back();
+		dish_.next(edges, rule_, 1, 2);
+		if (last > 1)
+		{
+			dish_.next(edges, rule_, last, last + 1);
+		}
+		for (auto const& changes : changes_)
+		{
+			dish_.modify(changes);
+		}
+		++generation_;
+		generationTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		return true;
+	}
+
+	uint32_t Strip::generation() const
+	{
+		return generation_;
+	}
+
+	const lifegame::Dish& Strip::dish() const
+	{
+		return dish_;
+	}
+
+	bool Strip::above() const
+	{
+		return layout_.count > 1 && (layout_.index > 0 || dish_.topology() == lifegame::Topology::Torus);
+	}
+
+	bool Strip::below() const
+	{
+		return layout_.count > 1 && (layout_.index + 1 < layout_.count || dish_.topology() == lifegame::Topology::Torus);
+	}
+
+	void Strip::receive()
+	{
+		// A row : [generation (4 bytes, big endian), states...], its states packed as bits.
+		// A row of another width comes from a neighbour of other columns : the strip fails rather than reading past the row.
+		const size_t width = (dish_.columns() - 2 + 7) / 8;
+		auto store = [this, width](std::map<uint32_t, std::vector<uint8_t>>& rows, const std::vector<uint8_t>& packet) {
+			if (packet.size() != 4 + width)
+			{
+				if (!failed_)
+				{
+					std::cerr << "Strip received a row of " << packet.size() << " bytes instead of: " << 4 + width << std::endl;
+				}
+				failed_ = true;
+				return;
+			}
+			uint32_t generation = (static_cast<uint32_t>(packet[0]) << 24) | (packet[1] << 16) | (packet[2] << 8) | packet[3];
+			rows[generation].assign(packet.cbegin() + 4, packet.cend());
+		};
+
+		std::map<uint64_t, std::unique_ptr<network::event::Event>> events;
+		server_.process(events);
+		for (auto const& event : events)
+		{
+			if (event.second->is<network::event::Connection>() && !accepted_)
+			{
+				upper_ = event.first;
+				accepted_ = true;
+				std::cout << "Strip accepted the strip above: " << (layout_.index + layout_.count - 1) % layout_.count << std::endl;
+			}
+			else if (event.second->is<network::event::Disconnection>() && accepted_ && event.first == upper_)
+			{
+				accepted_ = false;
+			}
+			else if (event.second->is<network::event::Exchange>() && event.first == upper_)
+			{
+				store(uppers_, event.second->as<network::event::Exchange>()->packet());
+			}
+		}
+		if (connected_)
+		{
+			while (auto const& event = client_.process())
+			{
+				if (event->is<network::event::Disconnection>())
+				{
+					connected_ = false;
+					break;
+				}
+				else if (event->is<network::event::Exchange>())
+				{
+					store(lowers_, event->as<network::event::Exchange>()->packet());
+				}
+			}
+		}
+	}
+
+	void Strip::send(uint8_t row, bool upward)
+	{
+		std::vector<uint8_t> packet;
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			packet.push_back(static_cast<uint8_t>(generation_ >> shift));
+		}
+		dish_.pack(row, packet);
+		bool sent = upward ? server_.send(upper_, packet.data(), static_cast<unsigned int>(packet.size())) : client_.send(packet.data(), static_cast<unsigned int>(packet.size()));
+		if (!sent)
+		{
+			std::cerr << "Strip sending error: " << network::error::latest() << std::endl;
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#include <server/TickScheduler.hpp>
+#include <assert.h>
+
+namespace server
+{
+	void TickScheduler::subscribe(uint64_t subscriber, unsigned int rate, Clock::time_point now)
+	{
+		assert(rate > 0);
+		auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / rate;
+		auto version = ++versions_;
+		subscriptions_[subscriber] = Subscription{ period, version };
+		ticks_.push(Tick{ now + period, subscriber, version });
+	}
+
+	void TickScheduler::unsubscribe(uint64_t subscriber)
+	{
+		subscriptions_.erase(subscriber);
+	}
+
+	void TickScheduler::due(Clock::time_point now, std::vector<uint64_t>& subscribers)
+	{
+		while (!ticks_.empty() && ticks_.top().time <= now)
+		{
+			Tick tick = ticks_.top();
+			ticks_.pop();
+
+			auto iterator = subscriptions_.find(tick.subscriber);
+			if (iterator == subscriptions_.end() || iterator->second.version != tick.version)
+			{
+				continue; // Cancelled subscription.
+			}
+
+			// Keep the pace without drifting, but don't try to catch up the ticks missed by a late caller.
+			auto& subscription = iterator->second;
+			tick.time += subscription.period;
+			if (tick.time <= now)
+			{
+				tick.time = now + subscription.period;
+			}
+			ticks_.push(tick);
+			subscribers.push_back(tick.subscriber);
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#if defined(__linux__)
+#include <server/Files.hpp>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace server
+{
+	/*
+	* @brief Flush a file or a directory to disk.
+	*
+	* @param path the path.
+	* @param flags the flags to open the path with.
+	*
+	* @return whether (or not) the path has been flushed.
+	*/
+	static bool sync(const std::string& path, int flags)
+	{
+		int file = ::open(path.c_str(), flags);
+		if (file < 0)
+		{
+			return false;
+		}
+		bool synced = ::fsync(file) == 0;
+		::close(file);
+		return synced;
+	}
+
+	bool replace(const std::string& temporary, const std::string& path)
+	{
+		if (!sync(temporary, O_WRONLY))
+		{
+			return false;
+		}
+		// Renaming over an existing file replaces it atomically.
+		if (std::rename(temporary.c_str(), path.c_str()) != 0)
+		{
+			return false;
+		}
+		// The rename itself is flushed with the directory : a failure there leaves the file replaced anyway.
+		auto separator = path.find_last_of('/');
+		sync(separator == std::string::npos ? "." : separator == 0 ? "/" : path.substr(0, separator), O_RDONLY);
+		return true;
+	}
+}
+#endif
@@ -0,0 +1,91 @@
+#if defined(__linux__)
+#include <server/MappedFile.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace server
+{
+	class MappedFile::MappedFileImpl
+	{
+	public:
+		MappedFileImpl() = default;
+		MappedFileImpl(const MappedFileImpl& other) = delete;
+		MappedFileImpl& operator=(const MappedFileImpl& other) = delete;
+		~MappedFileImpl()
+		{
+			close();
+		}
+
+		bool open(const std::string& path)
+		{
+			close();
+			int file = ::open(path.c_str(), O_RDONLY);
+			if (file < 0)
+			{
+				return false;
+			}
+			struct stat status;
+			if (::fstat(file, &status) < 0 || status.st_size <= 0)
+			{
+				::close(file);
+				return false;
+			}
+			// The mapping outlives the file descriptor.
+			void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			::close(file);
+			if (data == MAP_FAILED)
+			{
+				return false;
+			}
+			data_ = static_cast<const uint8_t*>(data);
+			size_ = static_cast<size_t>(status.st_size);
+			return true;
+		}
+
+		void close()
+		{
+			if (data_ != nullptr)
+			{
+				::munmap(const_cast<uint8_t*>(data_), size_);
+				data_ = nullptr;
+				size_ = 0;
+			}
+		}
+
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+	};
+
+	MappedFile::MappedFile() : impl_(std::make_unique<MappedFileImpl>())
+	{
+	}
+
+	MappedFile::MappedFile(MappedFile&& file) noexcept = default;
+
+	MappedFile& MappedFile::operator=(MappedFile&& file) noexcept = default;
+
+	MappedFile::~MappedFile() = default;
+
+	bool MappedFile::open(const std::string& path)
+	{
+		return impl_->open(path);
+	}
+
+	void MappedFile::close()
+	{
+		impl_->close();
+	}
+
+	const uint8_t* MappedFile::data() const
+	{
+		return impl_->data_;
+	}
+
+	size_t MappedFile::size() const
+	{
+		return impl_->size_;
+	}
+}
+#endif
@@ -0,0 +1,24 @@
+#if defined(_WIN32)
+#include <server/Files.hpp>
+#include <windows.h>
+
+namespace server
+{
+	bool replace(const std::string& temporary, const std::string& path)
+	{
+		HANDLE file = ::CreateFileA(temporary.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		bool flushed = ::FlushFileBuffers(file) != 0;
+		::CloseHandle(file);
+		if (!flushed)
+		{
+			return false;
+		}
+		// Unlike 'rename', an existing file is replaced rather than failing the move.
+		return ::MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+	}
+}
+#endif
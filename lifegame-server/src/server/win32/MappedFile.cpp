@@ -0,0 +1,94 @@
+#if defined(_WIN32)
+#include <server/MappedFile.hpp>
+#include <windows.h>
+
+namespace server
+{
+	class MappedFile::MappedFileImpl
+	{
+	public:
+		MappedFileImpl() = default;
+		MappedFileImpl(const MappedFileImpl& other) = delete;
+		MappedFileImpl& operator=(const MappedFileImpl& other) = delete;
+		~MappedFileImpl()
+		{
+			close();
+		}
+
+		bool open(const std::string& path)
+		{
+			close();
+			HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				return false;
+			}
+			LARGE_INTEGER size;
+			if (!::GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+			{
+				::CloseHandle(file);
+				return false;
+			}
+			// The view outlives the file & mapping handles.
+			HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			::CloseHandle(file);
+			if (mapping == nullptr)
+			{
+				return false;
+			}
+			void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			::CloseHandle(mapping);
+			if (data == nullptr)
+			{
+				return false;
+			}
+			data_ = static_cast<const uint8_t*>(data);
+			size_ = static_cast<size_t>(size.QuadPart);
+			return true;
+		}
+
+		void close()
+		{
+			if (data_ != nullptr)
+			{
+				::UnmapViewOfFile(data_);
+				data_ = nullptr;
+				size_ = 0;
+			}
+		}
+
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+	};
+
+	MappedFile::MappedFile() : impl_(std::make_unique<MappedFileImpl>())
+	{
+	}
+
+	MappedFile::MappedFile(MappedFile&& file) noexcept = default;
+
+	MappedFile& MappedFile::operator=(MappedFile&& file) noexcept = default;
+
+	MappedFile::~MappedFile() = default;
+
+	bool MappedFile::open(const std::string& path)
+	{
+		return impl_->open(path);
+	}
+
+	void MappedFile::close()
+	{
+		impl_->close();
+	}
+
+	const uint8_t* MappedFile::data() const
+	{
+		return impl_->data_;
+	}
+
+	size_t MappedFile::size() const
+	{
+		return impl_->size_;
+	}
+}
+#endif